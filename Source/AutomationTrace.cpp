@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+	AutomationTrace.cpp
+
+  ==============================================================================
+*/
+
+#include "AutomationTrace.h"
+
+namespace
+{
+	//==============================================================================
+	// -- Little endian helpers
+	inline void writeUInt16(char* destination, juce::uint16 value)
+	{
+		value = juce::ByteOrder::swapIfBigEndian(value);
+		std::memcpy(destination, &value, sizeof(value));
+	}
+
+	inline void writeUInt32(char* destination, juce::uint32 value)
+	{
+		value = juce::ByteOrder::swapIfBigEndian(value);
+		std::memcpy(destination, &value, sizeof(value));
+	}
+
+	inline void writeFloat(char* destination, float value)
+	{
+		juce::uint32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeUInt32(destination, bits);
+	}
+
+	inline juce::uint32 readUInt32(const char* source)
+	{
+		return juce::ByteOrder::littleEndianInt(source);
+	}
+
+	inline float readFloat(const char* source)
+	{
+		juce::uint32 bits = readUInt32(source);
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+}
+
+//==============================================================================
+// -- RECORDER
+//==============================================================================
+AutomationTraceRecorder::AutomationTraceRecorder()
+{
+}
+
+AutomationTraceRecorder::~AutomationTraceRecorder()
+{
+}
+
+//==============================================================================
+void AutomationTraceRecorder::start(double sampleRate, size_t capacityInBytes)
+{
+	const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+	capacity = juce::jmax(capacityInBytes, static_cast<size_t>(AutomationTrace::headerSize + AutomationTrace::maxBlockRecordSize));
+	data.allocate(capacity, false);
+
+	// -- Header
+	char* header = data.get();
+	writeUInt32(header, AutomationTrace::magic);
+	writeUInt16(header + 4, AutomationTrace::formatVersion);
+	writeUInt16(header + 6, static_cast<juce::uint16>(VersionIDs::V1_0_0));
+	writeUInt16(header + 8, static_cast<juce::uint16>(ControlID::countParams));
+	writeUInt16(header + 10, 0);
+	juce::uint64 sampleRateBits;
+	std::memcpy(&sampleRateBits, &sampleRate, sizeof(sampleRateBits));
+	sampleRateBits = juce::ByteOrder::swapIfBigEndian(sampleRateBits);
+	std::memcpy(header + 12, &sampleRateBits, sizeof(sampleRateBits));
+
+	size = AutomationTrace::headerSize;
+	hasKeyframe = false;
+	overflowed = false;
+	recording = true;
+}
+
+juce::MemoryBlock AutomationTraceRecorder::stop()
+{
+	const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+	recording = false;
+	overflowed = false;
+	juce::MemoryBlock trace(data.get(), size);
+	data.free();
+	capacity = 0;
+	size = 0;
+
+	return trace;
+}
+
+bool AutomationTraceRecorder::isRecording() const
+{
+	return recording.load(std::memory_order_relaxed);
+}
+
+bool AutomationTraceRecorder::hasOverflowed() const
+{
+	return overflowed.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+void AutomationTraceRecorder::recordBlock(int numSamples, PluginStateManager& stateManager)
+{
+	// -- the message thread only holds the lock while starting or stopping, skip the block rather than wait
+	const juce::SpinLock::ScopedTryLockType scopedLock(lock);
+	if (!scopedLock.isLocked() || !recording.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	if (size + AutomationTrace::maxBlockRecordSize > capacity)
+	{
+		overflowed = true;
+		recording = false;
+		return;
+	}
+
+	char* blockStart = data.get() + size;
+	char* valueWriter = blockStart + 4 + 4 * AutomationTrace::numMaskWords;
+	std::array<juce::uint32, AutomationTrace::numMaskWords> mask{};
+
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		float value = stateManager.getFloatValue(intToEnum(i, ControlID));
+		// -- bit compare, replay has to be exact
+		if (!hasKeyframe || std::memcmp(&value, &lastValues[i], sizeof(float)) != 0)
+		{
+			mask[i / 32] |= (1u << (i % 32));
+			writeFloat(valueWriter, value);
+			valueWriter += 4;
+			lastValues[i] = value;
+		}
+	}
+	hasKeyframe = true;
+
+	writeUInt32(blockStart, static_cast<juce::uint32>(numSamples));
+	for (int word{ 0 }; word < AutomationTrace::numMaskWords; ++word)
+	{
+		writeUInt32(blockStart + 4 + 4 * word, mask[word]);
+	}
+
+	size = static_cast<size_t>(valueWriter - data.get());
+}
+
+//==============================================================================
+// -- PLAYER
+//==============================================================================
+AutomationTracePlayer::AutomationTracePlayer()
+{
+}
+
+AutomationTracePlayer::~AutomationTracePlayer()
+{
+}
+
+//==============================================================================
+bool AutomationTracePlayer::load(const juce::MemoryBlock& trace)
+{
+	data = trace;
+	position = 0;
+	numBlocks = 0;
+	maxBlockSize = 0;
+
+	if (data.getSize() < AutomationTrace::headerSize)
+	{
+		return false;
+	}
+
+	const char* header = static_cast<const char*>(data.getData());
+	if (readUInt32(header) != AutomationTrace::magic
+		|| juce::ByteOrder::littleEndianShort(header + 4) != AutomationTrace::formatVersion
+		|| juce::ByteOrder::littleEndianShort(header + 8) != ControlID::countParams)
+	{
+		return false;
+	}
+
+	juce::uint64 sampleRateBits = juce::ByteOrder::littleEndianInt64(header + 12);
+	std::memcpy(&sampleRate, &sampleRateBits, sizeof(sampleRate));
+
+	// -- Scan once for the block count and the largest block
+	size_t readPosition = AutomationTrace::headerSize;
+	int numSamples = 0;
+	AutomationTrace::Values values{};
+	while (decodeBlock(readPosition, numSamples, values))
+	{
+		++numBlocks;
+		maxBlockSize = juce::jmax(maxBlockSize, numSamples);
+	}
+
+	rewind();
+	return numBlocks > 0;
+}
+
+double AutomationTracePlayer::getSampleRate() const
+{
+	return sampleRate;
+}
+
+int AutomationTracePlayer::getNumBlocks() const
+{
+	return numBlocks;
+}
+
+int AutomationTracePlayer::getMaxBlockSize() const
+{
+	return maxBlockSize;
+}
+
+//==============================================================================
+bool AutomationTracePlayer::readBlock(int& numSamples, AutomationTrace::Values& values)
+{
+	if (!decodeBlock(position, numSamples, currentValues))
+	{
+		return false;
+	}
+	values = currentValues;
+	return true;
+}
+
+void AutomationTracePlayer::rewind()
+{
+	position = AutomationTrace::headerSize;
+	currentValues.fill(0.f);
+}
+
+//==============================================================================
+bool AutomationTracePlayer::decodeBlock(size_t& readPosition, int& numSamples, AutomationTrace::Values& values) const
+{
+	const size_t maskSize = 4 + 4 * AutomationTrace::numMaskWords;
+	if (readPosition + maskSize > data.getSize())
+	{
+		return false;
+	}
+
+	const char* reader = static_cast<const char*>(data.getData()) + readPosition;
+	numSamples = static_cast<int>(readUInt32(reader));
+
+	std::array<juce::uint32, AutomationTrace::numMaskWords> mask;
+	int numChanged = 0;
+	for (int word{ 0 }; word < AutomationTrace::numMaskWords; ++word)
+	{
+		mask[word] = readUInt32(reader + 4 + 4 * word);
+		numChanged += juce::countNumberOfBits(mask[word]);
+	}
+
+	if (readPosition + maskSize + 4 * static_cast<size_t>(numChanged) > data.getSize())
+	{
+		return false;
+	}
+
+	reader += maskSize;
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		if ((mask[i / 32] & (1u << (i % 32))) != 0)
+		{
+			values[i] = readFloat(reader);
+			reader += 4;
+		}
+	}
+
+	readPosition += maskSize + 4 * static_cast<size_t>(numChanged);
+	return true;
+}
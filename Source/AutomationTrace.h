@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+	AutomationTrace.h
+	Capture and deterministic replay of the inbound parameter values seen by
+	PluginStateManager::syncInBoundVariables, block by block
+
+	Binary format (little endian):
+	-- header: 'THAT' magic (uint32), format version (uint16), parameter VersionIDs (uint16),
+	   number of parameters (uint16), reserved (uint16), sample rate (float64)
+	-- per block: number of samples (uint32), changed mask (uint32 words, one bit per ControlID),
+	   then one float32 per changed parameter in ControlID order. The first block has every bit set.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "parameterTypes.h"
+#include "PluginStateManager.h"
+
+namespace AutomationTrace
+{
+	//==============================================================================
+	static constexpr juce::uint32 magic{ 0x54414854 }; // -- "THAT"
+	static constexpr juce::uint16 formatVersion{ 1 };
+	static constexpr int headerSize{ 20 };
+	static constexpr int numMaskWords{ (ControlID::countParams + 31) / 32 };
+	static constexpr int maxBlockRecordSize{ 4 + 4 * numMaskWords + 4 * ControlID::countParams };
+
+	using Values = std::array<float, ControlID::countParams>;
+}
+
+//==============================================================================
+class AutomationTraceRecorder
+{
+public:
+	//==============================================================================
+	AutomationTraceRecorder();
+	~AutomationTraceRecorder();
+
+	//==============================================================================
+	// -- Message thread -- start allocates the whole capacity up front, hasOverflowed holds until stop
+	void start(double sampleRate, size_t capacityInBytes);
+	juce::MemoryBlock stop();
+	bool isRecording() const;
+	bool hasOverflowed() const;
+
+	//==============================================================================
+	// -- Audio thread -- never blocks or allocates, stops recording when the capacity is used up
+	void recordBlock(int numSamples, PluginStateManager& stateManager);
+
+private:
+	//==============================================================================
+	juce::SpinLock lock;
+	std::atomic<bool> recording{ false };
+	std::atomic<bool> overflowed{ false };
+
+	juce::HeapBlock<char> data;
+	size_t capacity{ 0 };
+	size_t size{ 0 };
+
+	bool hasKeyframe{ false };
+	AutomationTrace::Values lastValues{};
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(AutomationTraceRecorder)
+};
+
+//==============================================================================
+class AutomationTracePlayer
+{
+public:
+	//==============================================================================
+	AutomationTracePlayer();
+	~AutomationTracePlayer();
+
+	//==============================================================================
+	// -- Validates the header and scans the blocks, returns false for anything that is not a trace
+	bool load(const juce::MemoryBlock& trace);
+
+	double getSampleRate() const;
+	int getNumBlocks() const;
+	int getMaxBlockSize() const;
+
+	//==============================================================================
+	// -- Decodes the next block in place, false once the trace is exhausted
+	bool readBlock(int& numSamples, AutomationTrace::Values& values);
+	void rewind();
+
+private:
+	//==============================================================================
+	juce::MemoryBlock data;
+	size_t position{ 0 };
+
+	double sampleRate{ 0.0 };
+	int numBlocks{ 0 };
+	int maxBlockSize{ 0 };
+
+	AutomationTrace::Values currentValues{};
+
+	//==============================================================================
+	bool decodeBlock(size_t& readPosition, int& numSamples, AutomationTrace::Values& values) const;
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(AutomationTracePlayer)
+};
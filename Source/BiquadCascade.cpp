@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+	BiquadCascade.cpp
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+ #include <emmintrin.h>
+ #define TALKINGHEADS_CASCADE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define TALKINGHEADS_CASCADE_NEON 1
+#endif
+
+namespace
+{
+	//==============================================================================
+	// -- One register of four lanes
+#if TALKINGHEADS_CASCADE_SSE
+	struct LaneVector
+	{
+		using Register = __m128;
+
+		static Register load(const float* source) { return _mm_load_ps(source); }
+		static void store(float* destination, Register value) { _mm_store_ps(destination, value); }
+		static Register broadcast(float value) { return _mm_set1_ps(value); }
+		static Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+		static Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+		static Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+
+		using Mask = __m128;
+		static Mask loadMask(const juce::uint32* source) { return _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(source))); }
+		static Register select(Mask mask, Register ifSet, Register ifClear) { return _mm_or_ps(_mm_and_ps(mask, ifSet), _mm_andnot_ps(mask, ifClear)); }
+
+		// -- { carry[3], value[0], value[1], value[2] }
+		static Register shiftIn(Register value, Register carry)
+		{
+			const Register head = _mm_shuffle_ps(carry, value, _MM_SHUFFLE(0, 0, 3, 3));
+			return _mm_shuffle_ps(head, value, _MM_SHUFFLE(2, 1, 2, 0));
+		}
+
+		static float getLastLane(Register value) { return _mm_cvtss_f32(_mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3))); }
+	};
+#elif TALKINGHEADS_CASCADE_NEON
+	struct LaneVector
+	{
+		using Register = float32x4_t;
+
+		static Register load(const float* source) { return vld1q_f32(source); }
+		static void store(float* destination, Register value) { vst1q_f32(destination, value); }
+		static Register broadcast(float value) { return vdupq_n_f32(value); }
+		static Register add(Register a, Register b) { return vaddq_f32(a, b); }
+		static Register sub(Register a, Register b) { return vsubq_f32(a, b); }
+		static Register mul(Register a, Register b) { return vmulq_f32(a, b); }
+
+		using Mask = uint32x4_t;
+		static Mask loadMask(const juce::uint32* source) { return vld1q_u32(source); }
+		static Register select(Mask mask, Register ifSet, Register ifClear) { return vbslq_f32(mask, ifSet, ifClear); }
+
+		// -- { carry[3], value[0], value[1], value[2] }
+		static Register shiftIn(Register value, Register carry) { return vextq_f32(carry, value, 3); }
+
+		static float getLastLane(Register value) { return vgetq_lane_f32(value, 3); }
+	};
+#endif
+}
+
+//==============================================================================
+BiquadCascade::BiquadCascade()
+{
+}
+
+BiquadCascade::~BiquadCascade()
+{
+}
+
+//==============================================================================
+void BiquadCascade::reset()
+{
+	slotState1.fill(0.f);
+	slotState2.fill(0.f);
+}
+
+void BiquadCascade::clearSections()
+{
+	numSections = 0;
+}
+
+void BiquadCascade::addSection(int slot, const juce::dsp::IIR::Coefficients<float>& coefficients, bool isBypassed)
+{
+	jassert(slot >= 0 && slot < maxSections);
+	jassert(numSections < static_cast<size_t>(maxSections));
+	jassert(coefficients.coefficients.size() == 5); // -- second order sections only
+
+	const float* raw = coefficients.coefficients.begin();
+	b0[numSections] = raw[0];
+	b1[numSections] = raw[1];
+	b2[numSections] = raw[2];
+	a1[numSections] = raw[3];
+	a2[numSections] = raw[4];
+	bypassMasks[numSections] = isBypassed ? 0xffffffffu : 0u;
+	laneSlots[numSections] = static_cast<size_t>(slot);
+	++numSections;
+}
+
+int BiquadCascade::getNumSections() const
+{
+	return static_cast<int>(numSections);
+}
+
+void BiquadCascade::process(float* samples, int numSamples)
+{
+	if (numSections == 0 || numSamples <= 0)
+	{
+		return;
+	}
+
+#if TALKINGHEADS_CASCADE_SSE || TALKINGHEADS_CASCADE_NEON
+	const size_t numRegisters = (numSections + laneWidth - 1) / laneWidth;
+	const size_t numLanes = numRegisters * laneWidth;
+#else
+	const size_t numLanes = numSections;
+#endif
+
+	// -- Gather the slot states, lanes past the last section pass their input through
+	for (size_t lane{ 0 }; lane < numSections; ++lane)
+	{
+		state1[lane] = slotState1[laneSlots[lane]];
+		state2[lane] = slotState2[laneSlots[lane]];
+	}
+	for (size_t lane{ numSections }; lane < numLanes; ++lane)
+	{
+		b0[lane] = 1.f;
+		b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.f;
+		state1[lane] = state2[lane] = 0.f;
+		bypassMasks[lane] = 0u;
+	}
+
+	// -- Fill the pipeline, run it full, then drain it
+	const int numSteps = numSamples + static_cast<int>(numLanes) - 1;
+	laneInputs[0] = samples[0];
+
+	int step{ 0 };
+	for (; step < juce::jmin(static_cast<int>(numLanes) - 1, numSteps); ++step)
+	{
+		processStep(step, numLanes, samples, numSamples);
+	}
+
+#if TALKINGHEADS_CASCADE_SSE || TALKINGHEADS_CASCADE_NEON
+	switch (numRegisters)
+	{
+	case 1:
+		step = processSteadySteps<LaneVector, 1>(step, samples, numSamples);
+		break;
+	case 2:
+		step = processSteadySteps<LaneVector, 2>(step, samples, numSamples);
+		break;
+	default:
+		step = processSteadySteps<LaneVector, 3>(step, samples, numSamples);
+		break;
+	}
+#endif
+
+	for (; step < numSteps; ++step)
+	{
+		processStep(step, numLanes, samples, numSamples);
+	}
+
+	// -- Scatter the states back, IIR::Filter snaps them once per block as well
+	for (size_t lane{ 0 }; lane < numSections; ++lane)
+	{
+		juce::dsp::util::snapToZero(state1[lane]);
+		juce::dsp::util::snapToZero(state2[lane]);
+		slotState1[laneSlots[lane]] = state1[lane];
+		slotState2[laneSlots[lane]] = state2[lane];
+	}
+}
+
+//==============================================================================
+void BiquadCascade::processStep(int step, size_t numLanes, float* samples, int numSamples)
+{
+	// -- Last lane first, so each lane reads the output its lower neighbour made on the previous step
+	for (size_t lane{ numLanes }; lane-- > 0;)
+	{
+		const int sampleIndex = step - static_cast<int>(lane);
+		if (sampleIndex < 0 || sampleIndex >= numSamples)
+		{
+			continue;
+		}
+
+		// -- Bypassed sections update their state from the filtered output but pass the input on, as IIR::Filter does
+		const float input = laneInputs[lane];
+		const float output = input * b0[lane] + state1[lane];
+		state1[lane] = (input * b1[lane]) - (output * a1[lane]) + state2[lane];
+		state2[lane] = (input * b2[lane]) - (output * a2[lane]);
+		const float passed = bypassMasks[lane] != 0u ? input : output;
+
+		if (lane + 1 == numLanes)
+		{
+			samples[sampleIndex] = passed; // -- always behind the next read, safe in place
+		}
+		else
+		{
+			laneInputs[lane + 1] = passed;
+		}
+	}
+
+	if (step + 1 < numSamples)
+	{
+		laneInputs[0] = samples[step + 1];
+	}
+}
+
+template <typename Vector, size_t NumRegisters>
+int BiquadCascade::processSteadySteps(int step, float* samples, int numSamples)
+{
+	using Register = typename Vector::Register;
+	constexpr int numLanes = static_cast<int>(NumRegisters) * laneWidth;
+
+	Register coefficientsB0[NumRegisters];
+	Register coefficientsB1[NumRegisters];
+	Register coefficientsB2[NumRegisters];
+	Register coefficientsA1[NumRegisters];
+	Register coefficientsA2[NumRegisters];
+	Register states1[NumRegisters];
+	Register states2[NumRegisters];
+	Register inputs[NumRegisters];
+	typename Vector::Mask bypassed[NumRegisters];
+	for (size_t r{ 0 }; r < NumRegisters; ++r)
+	{
+		bypassed[r] = Vector::loadMask(bypassMasks.data() + r * laneWidth);
+		coefficientsB0[r] = Vector::load(b0.data() + r * laneWidth);
+		coefficientsB1[r] = Vector::load(b1.data() + r * laneWidth);
+		coefficientsB2[r] = Vector::load(b2.data() + r * laneWidth);
+		coefficientsA1[r] = Vector::load(a1.data() + r * laneWidth);
+		coefficientsA2[r] = Vector::load(a2.data() + r * laneWidth);
+		states1[r] = Vector::load(state1.data() + r * laneWidth);
+		states2[r] = Vector::load(state2.data() + r * laneWidth);
+		inputs[r] = Vector::load(laneInputs.data() + r * laneWidth);
+	}
+
+	// -- Every lane busy: the next input sample exists and the last lane outputs a finished sample
+	for (; step < numSamples - 1; ++step)
+	{
+		Register outputs[NumRegisters];
+		for (size_t r{ 0 }; r < NumRegisters; ++r)
+		{
+			outputs[r] = Vector::add(Vector::mul(inputs[r], coefficientsB0[r]), states1[r]);
+			states1[r] = Vector::add(Vector::sub(Vector::mul(inputs[r], coefficientsB1[r]), Vector::mul(outputs[r], coefficientsA1[r])), states2[r]);
+			states2[r] = Vector::sub(Vector::mul(inputs[r], coefficientsB2[r]), Vector::mul(outputs[r], coefficientsA2[r]));
+			outputs[r] = Vector::select(bypassed[r], inputs[r], outputs[r]);
+		}
+
+		samples[step - (numLanes - 1)] = Vector::getLastLane(outputs[NumRegisters - 1]);
+
+		inputs[0] = Vector::shiftIn(outputs[0], Vector::broadcast(samples[step + 1]));
+		for (size_t r{ 1 }; r < NumRegisters; ++r)
+		{
+			inputs[r] = Vector::shiftIn(outputs[r], outputs[r - 1]);
+		}
+	}
+
+	for (size_t r{ 0 }; r < NumRegisters; ++r)
+	{
+		Vector::store(state1.data() + r * laneWidth, states1[r]);
+		Vector::store(state2.data() + r * laneWidth, states2[r]);
+		Vector::store(laneInputs.data() + r * laneWidth, inputs[r]);
+	}
+	return step;
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	BiquadCascade.h
+	Runs a chain of biquads over a mono block in one pass
+
+	Each section is a transposed direct form II biquad, the same recurrence as
+	juce::dsp::IIR::Filter, so a cascade gives the same output as running the sections
+	one after the other. Coefficients and states live in one structure of arrays.
+
+	Sections of one sample depend on each other, so SIMD runs across sections as a
+	pipeline: lane j works on sample n - j while lane 0 takes sample n, and its output
+	moves one lane up per step. Four sections per SSE/NEON register and up to three
+	registers. The first and last steps of a block, where the pipeline fills and
+	drains, and targets without SSE/NEON run the same steps one lane at a time.
+
+	States are kept per slot, not per position in the chain: sections can drop out of
+	the cascade and come back with the state they had, like a filter that is not called.
+	A section added as bypassed instead behaves like an IIR::Filter in a ProcessorChain
+	with its bypass set: it keeps running its recurrence, so its state stays warm, but
+	passes its input on unchanged.
+
+	MultiBandEQ runs its pass filters and bands through one cascade when Optimised,
+	which is what the processor selects unless built with TALKINGHEADS_OPTIMISED_DSP=0.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+class BiquadCascade
+{
+public:
+	//==============================================================================
+	static constexpr int maxSections{ 11 };
+	static constexpr int laneWidth{ 4 };
+	static constexpr int maxLanes{ ((maxSections + laneWidth - 1) / laneWidth) * laneWidth };
+
+	//==============================================================================
+	BiquadCascade();
+	~BiquadCascade();
+
+	//==============================================================================
+	void reset();
+
+	// -- Rebuilt every block, in processing order, each slot at most once
+	void clearSections();
+	void addSection(int slot, const juce::dsp::IIR::Coefficients<float>& coefficients, bool isBypassed = false);
+	int getNumSections() const;
+
+	void process(float* samples, int numSamples);
+
+private:
+	//==============================================================================
+	// -- Per slot
+	std::array<float, maxSections> slotState1{};
+	std::array<float, maxSections> slotState2{};
+
+	// -- Per lane, rebuilt from the sections each block
+	std::array<size_t, maxSections> laneSlots{};
+	size_t numSections{ 0 };
+
+	alignas(16) std::array<float, maxLanes> b0{};
+	alignas(16) std::array<float, maxLanes> b1{};
+	alignas(16) std::array<float, maxLanes> b2{};
+	alignas(16) std::array<float, maxLanes> a1{};
+	alignas(16) std::array<float, maxLanes> a2{};
+	alignas(16) std::array<float, maxLanes> state1{};
+	alignas(16) std::array<float, maxLanes> state2{};
+	alignas(16) std::array<float, maxLanes> laneInputs{};
+	alignas(16) std::array<juce::uint32, maxLanes> bypassMasks{}; // -- all bits set: pass the input on
+
+	//==============================================================================
+	void processStep(int step, size_t numLanes, float* samples, int numSamples);
+
+	template <typename Vector, size_t NumRegisters>
+	int processSteadySteps(int step, float* samples, int numSamples);
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(BiquadCascade)
+};
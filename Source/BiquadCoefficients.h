@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+	BiquadCoefficients.h
+	Allocation free biquad designs, written into an existing IIR::Coefficients
+
+	IIR::Coefficients::makePeakFilter/makeLowPass/makeHighPass and FilterDesign return new
+	ref-counted objects, and copying them over a filter's coefficients reallocates the array.
+	These write the same five normalised values (b0, b1, b2, a1, a2) in place instead, so a
+	second order IIR::Coefficients can be redesigned from the audio thread. The maths and the
+	float/double mix follow juce_IIRFilter.cpp and juce_FilterDesign.cpp, so both paths give
+	the same coefficients.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+
+namespace BiquadCoefficients
+{
+	//==============================================================================
+	using Coefficients = juce::dsp::IIR::Coefficients<float>;
+
+	// -- Normalises by a0 like IIR::Coefficients does, the target must already hold a biquad
+	inline void assign(Coefficients& target, float b0, float b1, float b2, float a0, float a1, float a2)
+	{
+		jassert(target.coefficients.size() == 5);
+
+		const float a0Inv = !juce::approximatelyEqual(a0, 0.f) ? 1.f / a0 : 0.f;
+		float* raw = target.coefficients.getRawDataPointer();
+		raw[0] = b0 * a0Inv;
+		raw[1] = b1 * a0Inv;
+		raw[2] = b2 * a0Inv;
+		raw[3] = a1 * a0Inv;
+		raw[4] = a2 * a0Inv;
+	}
+
+	//==============================================================================
+	inline void makePeakFilter(Coefficients& target, double sampleRate, float frequency, float Q, float gainFactor)
+	{
+		jassert(sampleRate > 0.0);
+		jassert(frequency > 0.f && frequency <= static_cast<float>(sampleRate * 0.5));
+		jassert(Q > 0.f);
+		jassert(gainFactor > 0.f);
+
+		const auto A = juce::jmax(0.f, std::sqrt(gainFactor));
+		const auto omega = (2 * juce::MathConstants<float>::pi * juce::jmax(frequency, 2.f)) / static_cast<float>(sampleRate);
+		const auto alpha = std::sin(omega) / (Q * 2);
+		const auto c2 = -2 * std::cos(omega);
+		const auto alphaTimesA = alpha * A;
+		const auto alphaOverA = alpha / A;
+
+		assign(target, 1 + alphaTimesA, c2, 1 - alphaTimesA, 1 + alphaOverA, c2, 1 - alphaOverA);
+	}
+
+	inline void makeLowPass(Coefficients& target, double sampleRate, float frequency, float Q)
+	{
+		jassert(sampleRate > 0.0);
+		jassert(frequency > 0.f && frequency <= static_cast<float>(sampleRate * 0.5));
+		jassert(Q > 0.f);
+
+		const auto n = 1 / std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate));
+		const auto nSquared = n * n;
+		const auto invQ = 1 / Q;
+		const auto c1 = 1 / (1 + invQ * n + nSquared);
+
+		assign(target, c1, c1 * 2, c1, 1.f, c1 * 2 * (1 - nSquared), c1 * (1 - invQ * n + nSquared));
+	}
+
+	inline void makeHighPass(Coefficients& target, double sampleRate, float frequency, float Q)
+	{
+		jassert(sampleRate > 0.0);
+		jassert(frequency > 0.f && frequency <= static_cast<float>(sampleRate * 0.5));
+		jassert(Q > 0.f);
+
+		const auto n = std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate));
+		const auto nSquared = n * n;
+		const auto invQ = 1 / Q;
+		const auto c1 = 1 / (1 + invQ * n + nSquared);
+
+		assign(target, c1, c1 * -2, c1, 1.f, c1 * 2 * (nSquared - 1), c1 * (1 - invQ * n + nSquared));
+	}
+
+	//==============================================================================
+	// -- Q of each second order section of an even order Butterworth cascade (FilterDesign::designIIR*HighOrderButterworthMethod)
+	inline float getButterworthQ(int section, int order)
+	{
+		jassert(order > 0 && order % 2 == 0);
+		jassert(section >= 0 && section < order / 2);
+
+		return static_cast<float>(1.0 / (2.0 * std::cos((2.0 * section + 1.0) * juce::MathConstants<double>::pi / (order * 2.0))));
+	}
+}
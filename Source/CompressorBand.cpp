@@ -11,6 +11,23 @@
 #include <cmath>
 #include "CompressorBand.h"
 
+namespace
+{
+	double getSumOfSquares(const juce::dsp::AudioBlock<float>& block)
+	{
+		double sumOfSquares{ 0.0 };
+		for (size_t channel{ 0 }; channel < block.getNumChannels(); ++channel)
+		{
+			const float* samples = block.getChannelPointer(channel);
+			for (size_t i{ 0 }; i < block.getNumSamples(); ++i)
+			{
+				sumOfSquares += static_cast<double>(samples[i]) * samples[i];
+			}
+		}
+		return sumOfSquares;
+	}
+}
+
 //==============================================================================
 // -- CONSTRUCTORS
 //==============================================================================
@@ -29,19 +46,26 @@ CompressorBand::CompressorBand(
 	juce::dsp::LinkwitzRileyFilterType firstFilterType,
 	juce::dsp::LinkwitzRileyFilterType secondFilterType
 ) :
-	stateManager(stateManager),
-	muteID(muteID),
+	muteParam(*stateManager, muteID),
 	// -- Compressor
-	bypassID(bypassID),
-	thresholdID(thresholdID),
-	attackID(attackID),
-	releaseID(releaseID),
-	ratioID(ratioID),
-	// -- Filters
-	filterCrossoverFreqIDs{ firstFilterCrossoverFreqID, secondFilterCrossoverFreqID }
+	bypassParam(*stateManager, bypassID),
+	thresholdParam(*stateManager, thresholdID),
+	attackParam(*stateManager, attackID),
+	releaseParam(*stateManager, releaseID),
+	ratioParam(*stateManager, ratioID)
 {
 	filters[FilterIDs::firstFilter].setType(firstFilterType);
 	filters[FilterIDs::secondFilter].setType(secondFilterType);
+
+	// -- Filters -- allpass filters have no crossover parameter (ControlID::countParams)
+	std::array<ControlID, FilterIDs::countFilters> filterCrossoverFreqIDs{ firstFilterCrossoverFreqID, secondFilterCrossoverFreqID };
+	for (int i{ 0 }; i < FilterIDs::countFilters; ++i)
+	{
+		if (filters[i].getType() != juce::dsp::LinkwitzRileyFilterType::allpass)
+		{
+			filterCrossoverFreqParams[i] = ParameterHandle(*stateManager, filterCrossoverFreqIDs[i]);
+		}
+	}
 }
 
 CompressorBand::~CompressorBand()
@@ -51,7 +75,7 @@ CompressorBand::~CompressorBand()
 //==============================================================================
 void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
 {
-	mute = stateManager->getFloatValue(muteID);
+	mute = muteParam.getInBound();
 	isMuted = juce::approximatelyEqual(mute, 1.f);
 	prepareFilters(spec);
 	prepareCompressor(spec);
@@ -60,6 +84,7 @@ void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
 void CompressorBand::process(const juce::dsp::ProcessContextReplacing<float>& context)
 {
 	preProcess();
+	gainReductionDecibels = 0.f;
 
 	if (isMuted)
 	{
@@ -72,9 +97,26 @@ void CompressorBand::process(const juce::dsp::ProcessContextReplacing<float>& co
 	{
 		filter.process(context);
 	}
-	if (!isBypassed)
+	if (isBypassed)
+	{
+		return;
+	}
+	if (numMeteredSamples == 0)
 	{
 		compressor.process(context);
+		return;
+	}
+
+	// -- Gain reduction -- band energy before and after the compressor, over the block's samples only
+	const auto meteredBlock = context.getOutputBlock().getSubBlock(0, juce::jmin(numMeteredSamples, context.getOutputBlock().getNumSamples()));
+	const double inputEnergy = getSumOfSquares(meteredBlock);
+	compressor.process(context);
+	const double outputEnergy = getSumOfSquares(meteredBlock);
+	if (inputEnergy > 0.0 && outputEnergy < inputEnergy)
+	{
+		gainReductionDecibels = outputEnergy > 0.0
+			? static_cast<float>(10.0 * std::log10(inputEnergy / outputEnergy))
+			: 100.f; // -- fully silenced, report the usual minus infinity floor
 	}
 }
 
@@ -93,6 +135,16 @@ float CompressorBand::getLatency()
 	return 0.f; // TODO: check if filters or compressor add latency
 }
 
+float CompressorBand::getGainReductionDecibels() const
+{
+	return gainReductionDecibels;
+}
+
+void CompressorBand::setNumMeteredSamples(size_t numSamples)
+{
+	numMeteredSamples = numSamples;
+}
+
 //==============================================================================
 void CompressorBand::prepareFilters(const juce::dsp::ProcessSpec& spec)
 {
@@ -101,7 +153,7 @@ void CompressorBand::prepareFilters(const juce::dsp::ProcessSpec& spec)
 		crossoverFreqs[i] = 500.f;
 		if (filters[i].getType() != juce::dsp::LinkwitzRileyFilterType::allpass)
 		{
-			crossoverFreqs[i] = stateManager->getFloatValue(filterCrossoverFreqIDs[i]);
+			crossoverFreqs[i] = filterCrossoverFreqParams[i].getInBound();
 		}
 		filters[i].setCutoffFrequency(crossoverFreqs[i]);
 		filters[i].prepare(spec);
@@ -110,12 +162,12 @@ void CompressorBand::prepareFilters(const juce::dsp::ProcessSpec& spec)
 
 void CompressorBand::prepareCompressor(const juce::dsp::ProcessSpec& spec)
 {
-	bypass = stateManager->getFloatValue(bypassID);
+	bypass = bypassParam.getInBound();
 	isBypassed = juce::approximatelyEqual(bypass, 1.f);
-	compressor.setThreshold(stateManager->getFloatValue(thresholdID));
-	compressor.setAttack(stateManager->getFloatValue(attackID));
-	compressor.setRelease(stateManager->getFloatValue(releaseID));
-	compressor.setRatio(stateManager->getFloatValue(ratioID));
+	compressor.setThreshold(thresholdParam.getInBound());
+	compressor.setAttack(attackParam.getInBound());
+	compressor.setRelease(releaseParam.getInBound());
+	compressor.setRatio(ratioParam.getInBound());
 	compressor.prepare(spec);
 }
 
@@ -123,7 +175,7 @@ void CompressorBand::prepareCompressor(const juce::dsp::ProcessSpec& spec)
 void CompressorBand::preProcess()
 {
 	// -- Mute
-	float newMute = stateManager->getCurrentValue(muteID);
+	float newMute = muteParam.get();
 	if (!juce::approximatelyEqual(newMute, mute))
 	{
 		mute = newMute;
@@ -145,7 +197,7 @@ void CompressorBand::preProcessFilters()
 	{
 		if (filters[i].getType() != juce::dsp::LinkwitzRileyFilterType::allpass)
 		{
-			float newCrossoverFreq = stateManager->getCurrentValue(filterCrossoverFreqIDs[i]);
+			float newCrossoverFreq = filterCrossoverFreqParams[i].get();
 			if (!juce::approximatelyEqual(newCrossoverFreq, crossoverFreqs[i]))
 			{
 				crossoverFreqs[i] = newCrossoverFreq;
@@ -158,7 +210,7 @@ void CompressorBand::preProcessFilters()
 void CompressorBand::preProcessCompressor()
 {
 	// -- Bypass
-	float newBypass = stateManager->getCurrentValue(bypassID);
+	float newBypass = bypassParam.get();
 	bool bypassChanged = !juce::approximatelyEqual(newBypass, bypass);
 	if (bypassChanged)
 	{
@@ -172,7 +224,7 @@ void CompressorBand::preProcessCompressor()
 	}
 
 	// -- Threshold
-	float newThreshold = stateManager->getCurrentValue(thresholdID);
+	float newThreshold = thresholdParam.get();
 	if (!juce::approximatelyEqual(newThreshold, threshold))
 	{
 		threshold = newThreshold;
@@ -180,7 +232,7 @@ void CompressorBand::preProcessCompressor()
 	}
 
 	// -- Attack
-	float newAttack = stateManager->getCurrentValue(attackID);
+	float newAttack = attackParam.get();
 	if (!juce::approximatelyEqual(newAttack, attack))
 	{
 		attack = newAttack;
@@ -188,7 +240,7 @@ void CompressorBand::preProcessCompressor()
 	}
 
 	// -- Release
-	float newRelease = stateManager->getCurrentValue(releaseID);
+	float newRelease = releaseParam.get();
 	if (!juce::approximatelyEqual(newRelease, release))
 	{
 		release = newRelease;
@@ -196,7 +248,7 @@ void CompressorBand::preProcessCompressor()
 	}
 
 	// -- Ratio -- when bypassing we smooth the ratio to 1.f
-	float newRatio = stateManager->getCurrentValue(ratioID);
+	float newRatio = ratioParam.get();
 	if (!juce::approximatelyEqual(newRatio, ratio) || bypassChanged)
 	{
 		ratio = newRatio;
@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 #include "parameterTypes.h"
 #include "PluginStateManager.h"
+#include "ParameterHandle.h"
 
 class CompressorBand : public  juce::dsp::ProcessorBase
 {
@@ -44,20 +45,22 @@ public:
 
 	//==============================================================================
 	float getLatency();
+	float getGainReductionDecibels() const; // -- of the last processed block, 0 when muted, bypassed or not metered
+
+	// -- Samples of the next blocks to meter the gain reduction over, the band buffers are longer than the block; 0 skips metering
+	void setNumMeteredSamples(size_t numSamples);
 
 private:
 	//==============================================================================
 	// --- Object parameters management and information
-	std::shared_ptr<PluginStateManager> stateManager;
-
-	ControlID muteID{ ControlID::countParams };
+	ParameterHandle muteParam;
 
 	// -- Compressor
-	ControlID bypassID{ ControlID::countParams };
-	ControlID thresholdID{ ControlID::countParams };
-	ControlID attackID{ ControlID::countParams };
-	ControlID releaseID{ ControlID::countParams };
-	ControlID ratioID{ ControlID::countParams };
+	ParameterHandle bypassParam;
+	ParameterHandle thresholdParam;
+	ParameterHandle attackParam;
+	ParameterHandle releaseParam;
+	ParameterHandle ratioParam;
 
 	// -- Filters
 	enum FilterIDs
@@ -67,7 +70,7 @@ private:
 		// -- count
 		countFilters
 	};
-	std::array < ControlID, FilterIDs::countFilters> filterCrossoverFreqIDs;
+	std::array<ParameterHandle, FilterIDs::countFilters> filterCrossoverFreqParams; // -- unset for allpass filters
 
 	//==============================================================================
 	// --- Object member variables
@@ -83,6 +86,8 @@ private:
 	float ratio{ 0.f };
 
 	juce::dsp::Compressor<float> compressor;
+	float gainReductionDecibels{ 0.f };
+	size_t numMeteredSamples{ 0 };
 
 	// -- Filters
 	std::array<float, FilterIDs::countFilters> crossoverFreqs{ 0.f };
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+	DSPImplementation.h
+	Selects which implementation a DSP stage runs
+
+	Reference is the juce::dsp based code path every stage started from, and stays
+	the ground truth the talkingheads_equivalence harness compares against. Optimised
+	kernels (fused/SIMD filters, allocation free coefficient updates...) are only
+	selected with Optimised; stages without one of their own run Reference.
+
+	The processor runs Optimised unless built with TALKINGHEADS_OPTIMISED_DSP=0, so the
+	shipped plugin takes the Optimised path; tools can still switch an instance back
+	with TalkingHeadsPluginAudioProcessor::setDSPImplementation.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TALKINGHEADS_OPTIMISED_DSP
+#define TALKINGHEADS_OPTIMISED_DSP 1
+#endif
+
+//==============================================================================
+enum class DSPImplementation
+{
+	Reference,
+	Optimised
+};
+
+//==============================================================================
+constexpr DSPImplementation defaultDSPImplementation{ TALKINGHEADS_OPTIMISED_DSP ? DSPImplementation::Optimised : DSPImplementation::Reference };
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+	DirtyBitset.h
+	Lock-free set of dirty flags, one bit per index
+
+	Any thread marks bits, a single consumer (the audio thread) takes and clears
+	them all at once. Taking is one atomic exchange per 64 bits, so the consumer
+	only pays for the bits that are actually set.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if JUCE_MSVC
+#include <intrin.h>
+#endif
+
+//==============================================================================
+template <size_t numBits>
+class DirtyBitset
+{
+public:
+	//==============================================================================
+	static constexpr size_t numWords = (numBits + 63) / 64;
+	using Words = std::array<std::uint64_t, numWords>;
+
+	//==============================================================================
+	DirtyBitset()
+	{
+		for (auto& word : words)
+		{
+			word.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	//==============================================================================
+	// -- Producers, any thread
+	void mark(size_t bit) noexcept
+	{
+		jassert(bit < numBits);
+		words[bit >> 6].fetch_or(std::uint64_t{ 1 } << (bit & 63), std::memory_order_release);
+	}
+
+	void markAll() noexcept
+	{
+		for (size_t i{ 0 }; i < numWords; ++i)
+		{
+			words[i].fetch_or(getValidBits(i), std::memory_order_release);
+		}
+	}
+
+	//==============================================================================
+	// -- Consumer, returns the dirty bits and clears them
+	Words take() noexcept
+	{
+		Words taken{};
+		for (size_t i{ 0 }; i < numWords; ++i)
+		{
+			// -- skip the exchange (a write) when nothing is dirty, the common case
+			if (words[i].load(std::memory_order_relaxed) != 0)
+			{
+				taken[i] = words[i].exchange(0, std::memory_order_acquire);
+			}
+		}
+		return taken;
+	}
+
+	//==============================================================================
+	// -- Calls function(index) for every set bit in ascending order
+	template <typename Function>
+	static void forEachSetBit(const Words& bits, Function&& function)
+	{
+		for (size_t i{ 0 }; i < numWords; ++i)
+		{
+			for (auto word = bits[i]; word != 0; word &= word - 1)
+			{
+				function(static_cast<int>(i * 64 + countTrailingZeros(word)));
+			}
+		}
+	}
+
+	//==============================================================================
+	// -- Helpers for taken bits and masks
+	static constexpr Words makeRange(size_t firstBit, size_t endBit) noexcept
+	{
+		Words bits{};
+		for (size_t bit{ firstBit }; bit < endBit; ++bit)
+		{
+			bits[bit >> 6] |= std::uint64_t{ 1 } << (bit & 63);
+		}
+		return bits;
+	}
+
+	static bool test(const Words& bits, size_t bit) noexcept
+	{
+		return (bits[bit >> 6] >> (bit & 63)) & 1;
+	}
+
+	static void clear(Words& bits, size_t bit) noexcept
+	{
+		bits[bit >> 6] &= ~(std::uint64_t{ 1 } << (bit & 63));
+	}
+
+private:
+	//==============================================================================
+	std::array<std::atomic<std::uint64_t>, numWords> words;
+
+	//==============================================================================
+	static constexpr std::uint64_t getValidBits(size_t wordIndex) noexcept
+	{
+		return (wordIndex + 1) * 64 <= numBits ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << (numBits & 63)) - 1;
+	}
+
+	static size_t countTrailingZeros(std::uint64_t word) noexcept
+	{
+#if JUCE_MSVC
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return static_cast<size_t>(index);
+#else
+		return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+	}
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(DirtyBitset)
+};
@@ -20,11 +20,10 @@ EQBand::EQBand(
 	ControlID peakGainID,
 	ControlID peakQID
 ) :
-	stateManager(stateManager),
-	bypassID(bypassID),
-	peakFreqID(peakFreqID),
-	peakGainID(peakGainID),
-	peakQID(peakQID)
+	bypassParam(*stateManager, bypassID),
+	peakFreqParam(*stateManager, peakFreqID),
+	peakGainParam(*stateManager, peakGainID),
+	peakQParam(*stateManager, peakQID)
 {
 }
 
@@ -37,10 +36,15 @@ void EQBand::prepare(const juce::dsp::ProcessSpec& spec)
 {
 	sampleRate = spec.sampleRate;
 
-	peakFreq = stateManager->getFloatValue(peakFreqID);
-	peakGain = stateManager->getFloatValue(peakGainID);
-	peakQ = stateManager->getFloatValue(peakQID);
+	peakFreq = peakFreqParam.getInBound();
+	peakGain = peakGainParam.getInBound();
+	peakQ = peakQParam.getInBound();
 
+#if TALKINGHEADS_PEAK_COEFFICIENT_TABLE
+	peakCoefficientTable = PeakCoefficientTable::getShared(sampleRate);
+#endif
+
+	// -- not on the audio thread, always the Reference design: it also gives the coefficients their biquad layout for in place updates
 	updateCoefficients(
 		filter.coefficients,
 		makePeakFilter(peakFreq, peakGain, peakQ, sampleRate)
@@ -72,12 +76,36 @@ float EQBand::getLatency()
 	return 0.f; // TODO: check if EQ ads latency
 }
 
+MemoryFootprint EQBand::getMemoryFootprint()
+{
+	MemoryFootprint footprint;
+	footprint.add("coefficients", MemoryFootprint::getCoefficientsBytes(filter.coefficients.get()));
+	return footprint;
+}
+
 //==============================================================================
 void EQBand::setSampleRate(double sampleRate)
 {
 	this->sampleRate = sampleRate;
 }
 
+void EQBand::setImplementation(DSPImplementation newImplementation)
+{
+	implementation = newImplementation;
+}
+
+//==============================================================================
+bool EQBand::updateParameters()
+{
+	preProcess();
+	return !isBypassed;
+}
+
+const juce::dsp::IIR::Coefficients<float>& EQBand::getCoefficients() const
+{
+	return *filter.coefficients;
+}
+
 //==============================================================================
 using Filter = juce::dsp::IIR::Filter<float>;
 using CoefficientsPtr = Filter::CoefficientsPtr;
@@ -91,10 +119,32 @@ void EQBand::updateCoefficients(CoefficientsPtr& old, const CoefficientsPtr& rep
 	*old = *replacements;
 }
 
+void EQBand::updatePeakFilter(float peakQuality)
+{
+	if (implementation == DSPImplementation::Optimised)
+	{
+#if TALKINGHEADS_PEAK_COEFFICIENT_TABLE
+		// -- setSampleRate without a new prepare leaves the table at the old rate
+		if (peakCoefficientTable != nullptr && juce::approximatelyEqual(peakCoefficientTable->getSampleRate(), sampleRate))
+		{
+			peakCoefficientTable->makePeakFilter(*filter.coefficients, peakFreq, peakQuality, peakGain);
+			return;
+		}
+#endif
+		BiquadCoefficients::makePeakFilter(*filter.coefficients, sampleRate, peakFreq, peakQuality, juce::Decibels::decibelsToGain(peakGain));
+		return;
+	}
+
+	updateCoefficients(
+		filter.coefficients,
+		makePeakFilter(peakFreq, peakGain, peakQuality, sampleRate)
+	);
+}
+
 //==============================================================================
 void EQBand::preProcess()
 {
-	float newBypass = stateManager->getCurrentValue(bypassID);
+	float newBypass = bypassParam.get();
 	bool bypassChanged = !juce::approximatelyEqual(newBypass, bypass);
 	bypass = newBypass;
 
@@ -104,13 +154,13 @@ void EQBand::preProcess()
 		return;
 	}
 
-	float newPeakFreq = stateManager->getCurrentValue(peakFreqID);
+	float newPeakFreq = peakFreqParam.get();
 	bool peakFreqChanged = !juce::approximatelyEqual(newPeakFreq, peakFreq);
 
-	float newPeakGain = stateManager->getCurrentValue(peakGainID);
+	float newPeakGain = peakGainParam.get();
 	bool peakGainChanged = !juce::approximatelyEqual(newPeakGain, peakGain);
 
-	float newPeakQ = stateManager->getCurrentValue(peakQID);
+	float newPeakQ = peakQParam.get();
 	bool peakQChanged = !juce::approximatelyEqual(newPeakQ, peakQ);
 
 
@@ -120,9 +170,6 @@ void EQBand::preProcess()
 		peakGain = newPeakGain;
 		peakQ = newPeakQ;
 
-		updateCoefficients(
-			filter.coefficients,
-			makePeakFilter(peakFreq, peakGain, peakQ * (1.f - bypass), sampleRate)
-		);
+		updatePeakFilter(peakQ * (1.f - bypass));
 	}
 }
@@ -13,6 +13,11 @@
 #include <JuceHeader.h>
 #include "parameterTypes.h"
 #include "PluginStateManager.h"
+#include "ParameterHandle.h"
+#include "DSPImplementation.h"
+#include "BiquadCoefficients.h"
+#include "PeakCoefficientTable.h"
+#include "MemoryFootprint.h"
 
 //==============================================================================
 class EQBand : public  juce::dsp::ProcessorBase
@@ -37,23 +42,29 @@ public:
 
 	//==============================================================================
 	float getLatency();
+	MemoryFootprint getMemoryFootprint();
 
 	//==============================================================================
 	void setSampleRate(double sampleRate);
+	void setImplementation(DSPImplementation newImplementation);
+
+	//==============================================================================
+	// -- For callers running the filter themselves (MultiBandEQ's cascade): reads this block's parameters, false when bypassed
+	bool updateParameters();
+	const juce::dsp::IIR::Coefficients<float>& getCoefficients() const;
 
 private:
 	//==============================================================================
 	// --- Object parameters management and information
-	std::shared_ptr<PluginStateManager> stateManager;
-
-	ControlID bypassID{ ControlID::countParams };
-	ControlID peakFreqID{ ControlID::countParams };
-	ControlID peakGainID{ ControlID::countParams };
-	ControlID peakQID{ ControlID::countParams };
+	ParameterHandle bypassParam;
+	ParameterHandle peakFreqParam;
+	ParameterHandle peakGainParam;
+	ParameterHandle peakQParam;
 
 	//==============================================================================
 	// --- Object member variables
 	double sampleRate{ 0.f };
+	DSPImplementation implementation{ DSPImplementation::Reference };
 
 	bool isBypassed{ false };
 	float bypass{ 0.f };
@@ -64,12 +75,19 @@ private:
 	using Filter = juce::dsp::IIR::Filter<float>;
 	Filter filter;
 
+#if TALKINGHEADS_PEAK_COEFFICIENT_TABLE
+	std::shared_ptr<const PeakCoefficientTable> peakCoefficientTable; // -- shared by every band prepared at the same sample rate
+#endif
+
 	//==============================================================================
 	using CoefficientsPtr = Filter::CoefficientsPtr;
 	CoefficientsPtr makePeakFilter(float peakFreq, float peakGain, float peakQuality, double sampleRate);
 
 	void updateCoefficients(CoefficientsPtr& old, const CoefficientsPtr& replacements);
 
+	// -- Optimised designs in place, Reference allocates a new peak filter
+	void updatePeakFilter(float peakQuality);
+
 	//==============================================================================
 	void preProcess();
 };
@@ -1,29 +1,20 @@
 #pragma once
 
+#include <cmath>
 #include "Imager.h"
 
 //==============================================================================
 // -- CONSTRUCTORS
 //==============================================================================
-Imager::Imager(
-	std::shared_ptr<PluginStateManager> stateManager,
-	ControlID bypassID,
-	ControlID originalGainID,
-	ControlID auxiliarGainID,
-	ControlID widthID,
-	ControlID centerID,
-	ControlID delayTimeID,
-	ControlID crossoverFreqID,
-	ControlID imagerTypeID
-) :
-	stateManager(stateManager),
-	bypassID(bypassID),
-	gainIDs{ originalGainID, auxiliarGainID },
-	widthID(widthID),
-	centerID(centerID),
-	delayTimeID(delayTimeID),
-	crossoverFreqID(crossoverFreqID),
-	imagerTypeID(imagerTypeID)
+Imager::Imager(std::shared_ptr<PluginStateManager> stateManager) :
+	bypassParam(*stateManager),
+	originalGainParam(*stateManager),
+	auxiliarGainParam(*stateManager),
+	widthParam(*stateManager),
+	centerParam(*stateManager),
+	delayTimeParam(*stateManager),
+	crossoverFreqParam(*stateManager),
+	imagerTypeParam(*stateManager)
 {
 	filters[FilterIDs::lowpass].setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
 	filters[FilterIDs::highpass].setType(juce::dsp::LinkwitzRileyFilterType::highpass);
@@ -38,28 +29,28 @@ void Imager::prepare(const juce::dsp::ProcessSpec& spec)
 {
 	sampleRate = spec.sampleRate;
 
-	bypass = stateManager->getFloatValue(bypassID);
+	bypass = bypassParam.getInBound();
 	isBypassed = juce::approximatelyEqual(bypass, 1.f);
 
-	for (int i{ 0 }; i < SignalIDs::countSignals; i++)
-	{
-		gains[i] = stateManager->getFloatValue(gainIDs[i]);
-	}
+	width = widthParam.getInBound();
+	center = centerParam.getInBound();
+
+	juce::dsp::ProcessSpec monoSpec{ spec.sampleRate, spec.maximumBlockSize, 1 };
 
-	width = stateManager->getFloatValue(widthID);
-	center = stateManager->getFloatValue(centerID);
+	float maxDelayTime = delayTimeParam.getParameterRange().end;
+	stereoImagerDelayLine.setMaximumDelayInSamples(static_cast<int>(std::ceil(spec.sampleRate * maxDelayTime / 1000.0)) + 1);
+	stereoImagerDelayLine.prepare(monoSpec);
 
-	delayTime = stateManager->getFloatValue(delayTimeID);
+	delayTime = delayTimeParam.getInBound();
 	stereoImagerDelayLine.setDelay(getDelayTimeInSamples()); // -- delay time in samples (sampleRate * time in s)
-	stereoImagerDelayLine.prepare(spec);
 
-	crossoverFreq = stateManager->getFloatValue(crossoverFreqID);
+	crossoverFreq = crossoverFreqParam.getInBound();
 	filters[FilterIDs::lowpass].setCutoffFrequency(crossoverFreq);
 	filters[FilterIDs::highpass].setCutoffFrequency(crossoverFreq);
 	filters[FilterIDs::lowpass].prepare(spec);
 	filters[FilterIDs::highpass].prepare(spec);
 
-	lowpassBuffer.setSize(spec.numChannels, spec.maximumBlockSize);
+	lowpassBuffer.setSize(monoSpec.numChannels, monoSpec.maximumBlockSize);
 	lowpassBuffer.clear();
 }
 
@@ -104,43 +95,54 @@ void Imager::process(const juce::dsp::ProcessContextReplacing<float>& context)
 	float* leftOutSamples = outputBlock.getChannelPointer(LEFT_CHANNEL);
 	float* rightOutSamples = outputBlock.getChannelPointer(RIGHT_CHANNEL);
 
-	for (int i{ 0 }; i < numSamples; i++)
+	// -- Sample accurate gains and width, ramps are spread over the block instead of stepping once per block.
+	// -- The smoothed blocks hold the prepared maximum, a longer block runs in pieces (one sample each if never prepared)
+	const int maxPieceSize = juce::jmax(1, originalGainParam.getSmoothedBlockCapacity());
+	for (int start{ 0 }; start < numSamples; start += maxPieceSize)
 	{
-		stereoImagerDelayLine.pushSample(MONO_CHANNEL, inSamples[i]);
+		const int pieceSize = juce::jmin(maxPieceSize, numSamples - start);
+		const float* originalGains = originalGainParam.getSmoothedBlock(pieceSize);
+		const float* auxiliarGains = auxiliarGainParam.getSmoothedBlock(pieceSize);
+		const float* widths = imagerType == Imager::haasMidSide ? widthParam.getSmoothedBlock(pieceSize) : nullptr;
 
-		float originalSample = inSamples[i] * gains[SignalIDs::original];
-		float auxSample = stereoImagerDelayLine.popSample(MONO_CHANNEL) * gains[SignalIDs::auxiliar];
-
-		switch (imagerType)
-		{
-		case Imager::haas:
+		for (int i{ 0 }; i < pieceSize; i++)
 		{
-			leftOutSamples[i] = originalSample * (1.f - panningCoefficients[SignalIDs::original]) + auxSample * (1.f - panningCoefficients[SignalIDs::auxiliar]);
-			rightOutSamples[i] = originalSample * panningCoefficients[SignalIDs::original] + auxSample * panningCoefficients[SignalIDs::auxiliar];
-			break;
-		}
-		case Imager::haasMono:
-		{
-			leftOutSamples[i] = originalSample + auxSample * panningCoefficients[StereoIDs::left];
-			rightOutSamples[i] = originalSample + auxSample * panningCoefficients[StereoIDs::right];
-			break;
-		}
-		case Imager::haasMidSide:
-		{
-			// TODO: check if we use centre for something or not
-			float coef_S = width * 0.5;
-			float mid = originalSample * 0.5;
-			float side = auxSample * coef_S;
-
-			leftOutSamples[i] = mid - side;
-			rightOutSamples[i] = mid + side;
-			break;
-		}
+			stereoImagerDelayLine.pushSample(MONO_CHANNEL, inSamples[start + i]);
+
+			float originalSample = inSamples[start + i] * originalGains[i];
+			float auxSample = stereoImagerDelayLine.popSample(MONO_CHANNEL) * auxiliarGains[i];
+
+			switch (imagerType)
+			{
+			case Imager::haas:
+			{
+				leftOutSamples[start + i] = originalSample * (1.f - panningCoefficients[SignalIDs::original]) + auxSample * (1.f - panningCoefficients[SignalIDs::auxiliar]);
+				rightOutSamples[start + i] = originalSample * panningCoefficients[SignalIDs::original] + auxSample * panningCoefficients[SignalIDs::auxiliar];
+				break;
+			}
+			case Imager::haasMono:
+			{
+				leftOutSamples[start + i] = originalSample + auxSample * panningCoefficients[StereoIDs::left];
+				rightOutSamples[start + i] = originalSample + auxSample * panningCoefficients[StereoIDs::right];
+				break;
+			}
+			case Imager::haasMidSide:
+			{
+				// TODO: check if we use centre for something or not
+				float coef_S = widths[i] * 0.5f;
+				float mid = originalSample * 0.5;
+				float side = auxSample * coef_S;
+
+				leftOutSamples[start + i] = mid - side;
+				rightOutSamples[start + i] = mid + side;
+				break;
+			}
+			}
+
+			// -- Add lowpass signal to both channels
+			leftOutSamples[start + i] += lowpassSamples[start + i];
+			rightOutSamples[start + i] += lowpassSamples[start + i];
 		}
-
-		// -- Add lowpass signal to both channels
-		leftOutSamples[i] += lowpassSamples[i];
-		rightOutSamples[i] += lowpassSamples[i];
 	}
 }
 
@@ -156,6 +158,19 @@ float Imager::getLatency()
 	return 0.0f;
 }
 
+float Imager::getWidth() const
+{
+	return width;
+}
+
+MemoryFootprint Imager::getMemoryFootprint()
+{
+	MemoryFootprint footprint;
+	footprint.add("delayLine", MemoryFootprint::getDelayLineBytes(stereoImagerDelayLine, 1));
+	footprint.add("lowpassBuffer", MemoryFootprint::getBufferBytes(lowpassBuffer));
+	return footprint;
+}
+
 //==============================================================================
 void Imager::setSampleRate(int newSampleRate)
 {
@@ -171,7 +186,7 @@ float Imager::getDelayTimeInSamples()
 //==============================================================================
 void Imager::preProcess()
 {
-	float newBypass = stateManager->getCurrentValue(bypassID);
+	float newBypass = bypassParam.get();
 	bool bypassChanged = !juce::approximatelyEqual(newBypass, bypass);
 	bypass = newBypass;
 
@@ -182,22 +197,17 @@ void Imager::preProcess()
 	}
 
 	// TODO: check how to ramp gain to +0dB when bypassing changes
-	for (int i{ 0 }; i < SignalIDs::countSignals; i++)
-	{
-		gains[i] = stateManager->getCurrentValue(gainIDs[i]);
-	}
-
-	width = stateManager->getCurrentValue(widthID);
-	center = stateManager->getCurrentValue(centerID);
+	width = widthParam.get();
+	center = centerParam.get();
 
-	float newDelayTime = stateManager->getCurrentValue(delayTimeID);
+	float newDelayTime = delayTimeParam.get();
 	if (!juce::approximatelyEqual(newDelayTime, delayTime) || bypassChanged)
 	{
 		delayTime = newDelayTime;
 		stereoImagerDelayLine.setDelay((1.f - bypass) * getDelayTimeInSamples());
 	}
 
-	float newCrossoverFreq = stateManager->getCurrentValue(crossoverFreqID);
+	float newCrossoverFreq = crossoverFreqParam.get();
 	if (!juce::approximatelyEqual(newCrossoverFreq, crossoverFreq))
 	{
 		crossoverFreq = newCrossoverFreq;
@@ -205,7 +215,7 @@ void Imager::preProcess()
 		filters[FilterIDs::highpass].setCutoffFrequency(crossoverFreq);
 	}
 
-	imagerType = intToEnum(stateManager->getCurrentValue(imagerTypeID), ImagerTypes);
+	imagerType = intToEnum(imagerTypeParam.get(), ImagerTypes);
 
 	calculatePanningCoefficients();
 }
@@ -48,6 +48,8 @@
 #include <JuceHeader.h>
 #include "parameterTypes.h"
 #include "PluginStateManager.h"
+#include "ParameterHandle.h"
+#include "MemoryFootprint.h"
 
 //==============================================================================
 class Imager : public juce::dsp::ProcessorBase
@@ -56,17 +58,8 @@ public:
 	//==============================================================================
 	// -- CONSTRUCTORS
 	//==============================================================================
-	Imager(
-		std::shared_ptr<PluginStateManager> stateManager,
-		ControlID bypassID,
-		ControlID originalGainID,
-		ControlID auxiliarGainID,
-		ControlID widthID,
-		ControlID centerID,
-		ControlID delayTimeID,
-		ControlID crossoverFreqID,
-		ControlID imagerTypeID
-	);
+	// -- One imager per processor, its parameters are fixed at compile time
+	explicit Imager(std::shared_ptr<PluginStateManager> stateManager);
 	~Imager();
 
 	//==============================================================================
@@ -76,6 +69,8 @@ public:
 
 	//==============================================================================
 	float getLatency();
+	MemoryFootprint getMemoryFootprint();
+	float getWidth() const;
 
 	//==============================================================================
 	void setSampleRate(int newSampleRate);
@@ -101,15 +96,14 @@ private:
 	};
 
 	// --- Object parameters management and information
-	std::shared_ptr<PluginStateManager> stateManager;
-
-	ControlID bypassID{ ControlID::countParams };
-	std::array<ControlID, countSignals> gainIDs;
-	ControlID widthID{ ControlID::countParams };
-	ControlID centerID{ ControlID::countParams };
-	ControlID delayTimeID{ ControlID::countParams };
-	ControlID crossoverFreqID{ ControlID::countParams };
-	ControlID imagerTypeID{ ControlID::countParams };
+	Param<ControlID::imagerBypass> bypassParam;
+	Param<ControlID::imagerOriginalGain> originalGainParam;
+	Param<ControlID::imagerAuxiliarGain> auxiliarGainParam;
+	Param<ControlID::imagerWidth> widthParam;
+	Param<ControlID::imagerCenter> centerParam;
+	Param<ControlID::imagerDelayTime> delayTimeParam;
+	Param<ControlID::imagerCrossoverFreq> crossoverFreqParam;
+	Param<ControlID::imagerType> imagerTypeParam;
 
 	//==============================================================================
 	// --- Object member variables
@@ -119,13 +113,13 @@ private:
 	float isBypassed{ false };
 
 	// -- Imager
-	std::array<float, SignalIDs::countSignals> gains{ 0.5f, 0.5f };
 	float width{ 0.f };
 	float center{ 0.f };
 	std::array<float, SignalIDs::countSignals> panningCoefficients{ 0.f, 0.f };
 	float delayTime{ 0.f };
 
-	juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> stereoImagerDelayLine{ 192000 };
+	// -- sized in prepare from the delay time range at the prepared sample rate, only the mono channel is delayed
+	juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> stereoImagerDelayLine;
 
 	// -- Crossover -- allows to define from which freq the imager widens the stereo field
 	float crossoverFreq{ 0.f };
@@ -140,7 +134,7 @@ private:
 
 	using Filter = juce::dsp::LinkwitzRileyFilter<float>;
 	std::array<Filter, FilterIDs::countFilters> filters;
-	juce::AudioBuffer<float> lowpassBuffer;
+	juce::AudioBuffer<float> lowpassBuffer; // -- mono
 	juce::dsp::AudioBlock<float> lowpassBlock;
 
 	enum ImagerTypes
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+	MemoryFootprint.cpp
+
+  ==============================================================================
+*/
+
+#include "MemoryFootprint.h"
+
+//==============================================================================
+void MemoryFootprint::add(const juce::String& name, size_t bytes)
+{
+	components.push_back({ name, bytes });
+}
+
+void MemoryFootprint::add(const juce::String& prefix, const MemoryFootprint& other)
+{
+	for (const auto& component : other.components)
+	{
+		components.push_back({ prefix + "/" + component.name, component.bytes });
+	}
+}
+
+const std::vector<MemoryFootprint::Component>& MemoryFootprint::getComponents() const
+{
+	return components;
+}
+
+size_t MemoryFootprint::getTotalBytes() const
+{
+	size_t total = 0;
+	for (const auto& component : components)
+	{
+		total += component.bytes;
+	}
+	return total;
+}
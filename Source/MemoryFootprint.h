@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+	MemoryFootprint.h
+	Bytes owned by an instance, broken down by component
+
+	Components report the storage they size themselves: audio buffers, delay lines,
+	parameter objects and smoothers, plus the object itself. Allocator overhead and
+	juce internals we do not size (APVTS value tree, parameter objects) are not
+	included; talkingheads_bench_memory measures the heap to show what is left over.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+class MemoryFootprint
+{
+public:
+	//==============================================================================
+	struct Component
+	{
+		juce::String name;
+		size_t bytes;
+	};
+
+	//==============================================================================
+	void add(const juce::String& name, size_t bytes);
+	// -- Adds every component of other, prefixed with "prefix/"
+	void add(const juce::String& prefix, const MemoryFootprint& other);
+
+	const std::vector<Component>& getComponents() const;
+	size_t getTotalBytes() const;
+
+	//==============================================================================
+	template <typename SampleType>
+	static size_t getBufferBytes(const juce::AudioBuffer<SampleType>& buffer)
+	{
+		return static_cast<size_t>(buffer.getNumChannels()) * static_cast<size_t>(buffer.getNumSamples()) * sizeof(SampleType);
+	}
+
+	template <typename NumericType>
+	static size_t getCoefficientsBytes(const juce::dsp::IIR::Coefficients<NumericType>* coefficients)
+	{
+		return coefficients == nullptr ? 0 : sizeof(*coefficients) + static_cast<size_t>(coefficients->coefficients.size()) * sizeof(NumericType);
+	}
+
+	// -- DelayLine keeps two samples beyond its maximum delay per channel
+	template <typename SampleType, typename InterpolationType>
+	static size_t getDelayLineBytes(const juce::dsp::DelayLine<SampleType, InterpolationType>& delayLine, int numChannels)
+	{
+		return static_cast<size_t>(numChannels) * static_cast<size_t>(delayLine.getMaximumDelayInSamples() + 2) * sizeof(SampleType);
+	}
+
+private:
+	//==============================================================================
+	std::vector<Component> components;
+};
@@ -22,8 +22,7 @@ MultiBandCompressor::MultiBandCompressor(
 	CompressorBandParamIDs midBandParamIDs,
 	CompressorBandParamIDs highBandParamIDs
 ) :
-	stateManager(stateManager),
-	bypassID(bypassID),
+	bypassParam(*stateManager, bypassID),
 	compressorBands{
 		CompressorBand(
 			stateManager,
@@ -81,7 +80,7 @@ MultiBandCompressor::~MultiBandCompressor()
 //==============================================================================
 void MultiBandCompressor::prepare(const juce::dsp::ProcessSpec& spec)
 {
-	bypass = stateManager->getFloatValue(bypassID);
+	bypass = bypassParam.getInBound();
 
 	// -- Filter buffers
 	for (juce::AudioBuffer<float>& buffer : filterBuffers)
@@ -128,6 +127,7 @@ void MultiBandCompressor::process(const juce::dsp::ProcessContextReplacing<float
 	for (int i{ 0 }; i < numBands; ++i)
 	{
 		juce::dsp::ProcessContextReplacing<float> bandContext(filterBlocks[i]);
+		compressorBands[i].setNumMeteredSamples(isMeteringGainReduction ? outputBlock.getNumSamples() : 0);
 		compressorBands[i].process(bandContext);
 	}
 
@@ -159,8 +159,33 @@ float MultiBandCompressor::getLatency()
 	return latency;
 }
 
+float MultiBandCompressor::getGainReductionDecibels(int band) const
+{
+	jassert(band >= 0 && band < numBands);
+	if (juce::approximatelyEqual(bypass, 1.f))
+	{
+		return 0.f;
+	}
+	return compressorBands[band].getGainReductionDecibels();
+}
+
+void MultiBandCompressor::setGainReductionMetering(bool shouldMeter)
+{
+	isMeteringGainReduction = shouldMeter;
+}
+
+MemoryFootprint MultiBandCompressor::getMemoryFootprint()
+{
+	MemoryFootprint footprint;
+	for (size_t i{ 0 }; i < filterBuffers.size(); ++i)
+	{
+		footprint.add("filterBuffers[" + juce::String(i) + "]", MemoryFootprint::getBufferBytes(filterBuffers[i]));
+	}
+	return footprint;
+}
+
 //==============================================================================
 void MultiBandCompressor::preProcess()
 {
-	bypass = stateManager->getCurrentValue(bypassID);
+	bypass = bypassParam.get();
 }
\ No newline at end of file
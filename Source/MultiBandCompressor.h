@@ -19,7 +19,9 @@
 #include <memory>
 #include "parameterTypes.h"
 #include "CompressorBand.h"
+#include "ParameterHandle.h"
 #include "PluginStateManager.h"
+#include "MemoryFootprint.h"
 
 //==============================================================================
 class MultiBandCompressor : public juce::dsp::ProcessorBase
@@ -56,17 +58,19 @@ public:
 
 	//==============================================================================
 	float getLatency();
+	MemoryFootprint getMemoryFootprint();
+	float getGainReductionDecibels(int band) const; // -- 0 when bypassed or not metered
+	void setGainReductionMetering(bool shouldMeter); // -- audio thread, off when no one reads the gain reduction
 
 private:
 	//==============================================================================
 	// --- Object parameters management and information
-	std::shared_ptr<PluginStateManager> stateManager;
-
-	ControlID bypassID{ ControlID::countParams };
+	ParameterHandle bypassParam;
 
 	// --- Object member variables
 	float bypass{ 0.f };
 	bool isBypassed{ false };
+	bool isMeteringGainReduction{ false };
 
 	static const int numBands = 3;
 	std::array<CompressorBand, numBands> compressorBands;
@@ -16,28 +16,19 @@
 //==============================================================================
 MultiBandEQ::MultiBandEQ(
 	std::shared_ptr<PluginStateManager> stateManager,
-	// -- HPF
-	ControlID highpassBypassID,
-	ControlID highpassFreqID,
-	ControlID highpassSlopeID,
-	// -- LPF
-	ControlID lowpassBypassID,
-	ControlID lowpassFreqID,
-	ControlID lowpassSlopeID,
 	// -- Band Filters
 	EQBandParamIDs bandFilter1ParamIDs,
 	EQBandParamIDs bandFilter2ParamIDs,
 	EQBandParamIDs bandFilter3ParamIDs
 ) :
-	stateManager(stateManager),
 	// -- HPF
-	highpassBypassID(highpassBypassID),
-	highpassFreqID(highpassFreqID),
-	highpassSlopeID(highpassSlopeID),
+	highpassBypassParam(*stateManager),
+	highpassFreqParam(*stateManager),
+	highpassSlopeParam(*stateManager),
 	// -- LPF
-	lowpassBypassID(lowpassBypassID),
-	lowpassFreqID(lowpassFreqID),
-	lowpassSlopeID(lowpassSlopeID),
+	lowpassBypassParam(*stateManager),
+	lowpassFreqParam(*stateManager),
+	lowpassSlopeParam(*stateManager),
 	// -- Band Filters
 	bandFilters{
 		EQBand(
@@ -75,19 +66,23 @@ void MultiBandEQ::prepare(const juce::dsp::ProcessSpec& spec)
 	sampleRate = spec.sampleRate;
 
 	// -- Highpass
-	highpassBypass = stateManager->getFloatValue(highpassBypassID);
+	highpassBypass = highpassBypassParam.getInBound();
 	highpassBypassed = juce::approximatelyEqual(highpassBypass, 1.0f);
-	highpassFreq = stateManager->getFloatValue(highpassFreqID);
-	highpassSlope = intToEnum(stateManager->getChoiceIndex(highpassSlopeID), Slope);
-	updatePassFilter(highpassFilter, makeHighpass(sampleRate), highpassSlope);
+	highpassFreq = highpassFreqParam.getInBound();
+	highpassSlope = intToEnum(highpassSlopeParam.getChoiceIndex(), Slope);
+	// -- Designing all four sections first gives each one a biquad layout, the in place designs
+	// -- (Optimised) only rewrite the values, so a slope change later must not meet an unset section
+	updatePassFilter(highpassFilter, makeHighpass(sampleRate, Slope::Slope_48), Slope::Slope_48);
+	updatePassFilter(highpassFilter, makeHighpass(sampleRate, highpassSlope), highpassSlope);
 	highpassFilter.prepare(spec);
 
 	// -- Lowpass
-	lowpassBypass = stateManager->getFloatValue(lowpassBypassID);
+	lowpassBypass = lowpassBypassParam.getInBound();
 	lowpassBypassed = juce::approximatelyEqual(lowpassBypass, 1.0f);
-	lowpassFreq = stateManager->getFloatValue(lowpassFreqID);
-	lowpassSlope = intToEnum(stateManager->getChoiceIndex(lowpassSlopeID), Slope);
-	updatePassFilter(lowpassFilter, makeLowpass(sampleRate), lowpassSlope);
+	lowpassFreq = lowpassFreqParam.getInBound();
+	lowpassSlope = intToEnum(lowpassSlopeParam.getChoiceIndex(), Slope);
+	updatePassFilter(lowpassFilter, makeLowpass(sampleRate, Slope::Slope_48), Slope::Slope_48);
+	updatePassFilter(lowpassFilter, makeLowpass(sampleRate, lowpassSlope), lowpassSlope);
 	lowpassFilter.prepare(spec);
 
 	// -- Bands
@@ -95,11 +90,19 @@ void MultiBandEQ::prepare(const juce::dsp::ProcessSpec& spec)
 	{
 		bandFilter.prepare(spec);
 	}
+
+	cascade.reset();
 }
 
 void MultiBandEQ::process(const juce::dsp::ProcessContextReplacing<float>& context)
 {
 	preProcess();
+	if (implementation == DSPImplementation::Optimised)
+	{
+		processCascade(context);
+		return;
+	}
+
 	if (!highpassBypassed)
 	{
 		highpassFilter.process(context);
@@ -122,6 +125,7 @@ void MultiBandEQ::reset()
 	{
 		bandFilter.reset();
 	}
+	cascade.reset();
 }
 
 //==============================================================================
@@ -131,10 +135,35 @@ void MultiBandEQ::preProcess()
 	postUpdateLowpassFilter();
 }
 
+void MultiBandEQ::processCascade(const juce::dsp::ProcessContextReplacing<float>& context)
+{
+	cascade.clearSections();
+	if (!highpassBypassed)
+	{
+		addCascadeSections(highpassFilter, CascadeSlots::highpassSlots);
+	}
+	if (!lowpassBypassed)
+	{
+		addCascadeSections(lowpassFilter, CascadeSlots::lowpassSlots);
+	}
+	for (int i{ 0 }; i < numBands; ++i)
+	{
+		if (bandFilters[i].updateParameters())
+		{
+			cascade.addSection(CascadeSlots::bandSlots + i, bandFilters[i].getCoefficients());
+		}
+	}
+
+	// -- IIR::Filter is mono, so is the cascade
+	auto& outputBlock = context.getOutputBlock();
+	jassert(outputBlock.getNumChannels() == 1);
+	cascade.process(outputBlock.getChannelPointer(0), static_cast<int>(outputBlock.getNumSamples()));
+}
+
 void MultiBandEQ::postUpdateHighpassFilter()
 {
-	float newBypass = stateManager->getCurrentValue(highpassBypassID);
-	bool bypassChanged = juce::approximatelyEqual(newBypass, highpassBypass);
+	float newBypass = highpassBypassParam.get();
+	bool bypassChanged = !juce::approximatelyEqual(newBypass, highpassBypass);
 	highpassBypass = newBypass;
 	highpassBypassed = juce::approximatelyEqual(highpassBypass, 1.0f);
 	if (highpassBypassed)
@@ -142,10 +171,10 @@ void MultiBandEQ::postUpdateHighpassFilter()
 		return;
 	}
 
-	float newFreq = stateManager->getCurrentValue(highpassFreqID);
-	bool freqChanged = juce::approximatelyEqual(newFreq, highpassFreq);
+	float newFreq = highpassFreqParam.get();
+	bool freqChanged = !juce::approximatelyEqual(newFreq, highpassFreq);
 
-	Slope newSlope = intToEnum(stateManager->getChoiceIndex(highpassSlopeID), Slope);
+	Slope newSlope = intToEnum(highpassSlopeParam.getChoiceIndex(), Slope);
 	bool slopeChanged = newSlope != highpassSlope;
 
 
@@ -153,14 +182,14 @@ void MultiBandEQ::postUpdateHighpassFilter()
 	{
 		highpassFreq = newFreq;
 		highpassSlope = newSlope;
-		updatePassFilter(highpassFilter, makeHighpass(sampleRate), highpassSlope);
+		updateHighpassFilter();
 	}
 }
 
 void MultiBandEQ::postUpdateLowpassFilter()
 {
-	float newBypass = stateManager->getCurrentValue(lowpassBypassID);
-	bool bypassChanged = juce::approximatelyEqual(newBypass, lowpassBypass);
+	float newBypass = lowpassBypassParam.get();
+	bool bypassChanged = !juce::approximatelyEqual(newBypass, lowpassBypass);
 	lowpassBypass = newBypass;
 	lowpassBypassed = juce::approximatelyEqual(lowpassBypass, 1.0f);
 	if (lowpassBypassed)
@@ -168,17 +197,17 @@ void MultiBandEQ::postUpdateLowpassFilter()
 		return;
 	}
 
-	float newFreq = stateManager->getCurrentValue(lowpassFreqID);
-	bool freqChanged = juce::approximatelyEqual(newFreq, lowpassFreq);
+	float newFreq = lowpassFreqParam.get();
+	bool freqChanged = !juce::approximatelyEqual(newFreq, lowpassFreq);
 
-	Slope newSlope = intToEnum(stateManager->getChoiceIndex(lowpassSlopeID), Slope);
+	Slope newSlope = intToEnum(lowpassSlopeParam.getChoiceIndex(), Slope);
 	bool slopeChanged = newSlope != lowpassSlope;
 
 	if (bypassChanged || freqChanged || slopeChanged)
 	{
 		lowpassFreq = newFreq;
 		lowpassSlope = newSlope;
-		updatePassFilter(lowpassFilter, makeLowpass(sampleRate), lowpassSlope);
+		updateLowpassFilter();
 	}
 }
 
@@ -187,31 +216,135 @@ float MultiBandEQ::getLatency()
 	return 0.f;
 }
 
+MemoryFootprint MultiBandEQ::getMemoryFootprint()
+{
+	MemoryFootprint footprint;
+	footprint.add("highpassFilter", getPassFilterBytes(highpassFilter));
+	footprint.add("lowpassFilter", getPassFilterBytes(lowpassFilter));
+	for (size_t i{ 0 }; i < bandFilters.size(); ++i)
+	{
+		footprint.add("bandFilter" + juce::String(i + 1), bandFilters[i].getMemoryFootprint());
+	}
+	return footprint;
+}
+
 //==============================================================================
 void MultiBandEQ::setSampleRate(double sampleRate)
 {
 	this->sampleRate = sampleRate;
 }
 
+void MultiBandEQ::setImplementation(DSPImplementation newImplementation)
+{
+	implementation = newImplementation;
+	for (auto& bandFilter : bandFilters)
+	{
+		bandFilter.setImplementation(implementation);
+	}
+}
+
 //==============================================================================
 // -- Filters
 using Coefficients = juce::dsp::IIR::Coefficients<float>;
 using Filter = juce::dsp::IIR::Filter<float>;
 
-juce::ReferenceCountedArray<Coefficients> MultiBandEQ::makeHighpass(double sampleRate)
+juce::ReferenceCountedArray<Coefficients> MultiBandEQ::makeHighpass(double sampleRate, const Slope& slope)
 {
 	return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
 		highpassFreq,
 		sampleRate,
-		2 * (highpassSlope + 1));
+		2 * (slope + 1));
 }
 
-juce::ReferenceCountedArray<Coefficients> MultiBandEQ::makeLowpass(double sampleRate)
+juce::ReferenceCountedArray<Coefficients> MultiBandEQ::makeLowpass(double sampleRate, const Slope& slope)
 {
 	return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
 		lowpassFreq,
 		sampleRate,
-		2 * (lowpassSlope + 1));
+		2 * (slope + 1));
+}
+
+void MultiBandEQ::updateHighpassFilter()
+{
+	if (implementation == DSPImplementation::Optimised)
+	{
+		designPassFilter(highpassFilter, true, highpassFreq, highpassSlope);
+		return;
+	}
+	updatePassFilter(highpassFilter, makeHighpass(sampleRate, highpassSlope), highpassSlope);
+}
+
+void MultiBandEQ::updateLowpassFilter()
+{
+	if (implementation == DSPImplementation::Optimised)
+	{
+		designPassFilter(lowpassFilter, false, lowpassFreq, lowpassSlope);
+		return;
+	}
+	updatePassFilter(lowpassFilter, makeLowpass(sampleRate, lowpassSlope), lowpassSlope);
+}
+
+template <int Index>
+void MultiBandEQ::designSection(PassFilter& filter, bool isHighpass, float freq, int order)
+{
+	auto& coefficients = *filter.template get<Index>().coefficients;
+	const float q = BiquadCoefficients::getButterworthQ(Index, order);
+	if (isHighpass)
+	{
+		BiquadCoefficients::makeHighPass(coefficients, sampleRate, freq, q);
+	}
+	else
+	{
+		BiquadCoefficients::makeLowPass(coefficients, sampleRate, freq, q);
+	}
+	filter.template setBypassed<Index>(false);
+}
+
+void MultiBandEQ::designPassFilter(PassFilter& filter, bool isHighpass, float freq, const Slope& slope)
+{
+	filter.template setBypassed<Slope::Slope_12>(true);
+	filter.template setBypassed<Slope::Slope_24>(true);
+	filter.template setBypassed<Slope::Slope_36>(true);
+	filter.template setBypassed<Slope::Slope_48>(true);
+
+	const int order = 2 * (slope + 1);
+	switch (slope)
+	{
+	case Slope::Slope_48:
+		designSection<Slope::Slope_48>(filter, isHighpass, freq, order);
+		[[fallthrough]];
+	case Slope::Slope_36:
+		designSection<Slope::Slope_36>(filter, isHighpass, freq, order);
+		[[fallthrough]];
+	case Slope::Slope_24:
+		designSection<Slope::Slope_24>(filter, isHighpass, freq, order);
+		[[fallthrough]];
+	case Slope::Slope_12:
+		designSection<Slope::Slope_12>(filter, isHighpass, freq, order);
+	}
+}
+
+template <int Index>
+void MultiBandEQ::addCascadeSection(PassFilter& filter, int firstSlot)
+{
+	// -- Sections the slope does not use stay in, bypassed: ProcessorChain keeps running their state
+	cascade.addSection(firstSlot + Index, *filter.template get<Index>().coefficients, filter.template isBypassed<Index>());
+}
+
+void MultiBandEQ::addCascadeSections(PassFilter& filter, int firstSlot)
+{
+	addCascadeSection<Slope::Slope_12>(filter, firstSlot);
+	addCascadeSection<Slope::Slope_24>(filter, firstSlot);
+	addCascadeSection<Slope::Slope_36>(filter, firstSlot);
+	addCascadeSection<Slope::Slope_48>(filter, firstSlot);
+}
+
+size_t MultiBandEQ::getPassFilterBytes(PassFilter& passFilter)
+{
+	return MemoryFootprint::getCoefficientsBytes(passFilter.get<Slope::Slope_12>().coefficients.get())
+		+ MemoryFootprint::getCoefficientsBytes(passFilter.get<Slope::Slope_24>().coefficients.get())
+		+ MemoryFootprint::getCoefficientsBytes(passFilter.get<Slope::Slope_36>().coefficients.get())
+		+ MemoryFootprint::getCoefficientsBytes(passFilter.get<Slope::Slope_48>().coefficients.get());
 }
 
 using CoefficientsPtr = Filter::CoefficientsPtr;
@@ -228,7 +361,7 @@ void MultiBandEQ::update(PassFilter& filter, const CoefficientType& coefficients
 }
 
 template <typename CoefficientType>
-void MultiBandEQ::updatePassFilter(PassFilter& filter, CoefficientType& coefficients, const Slope& slope)
+void MultiBandEQ::updatePassFilter(PassFilter& filter, const CoefficientType& coefficients, const Slope& slope)
 {
 	filter.template setBypassed<Slope::Slope_12>(true);
 	filter.template setBypassed<Slope::Slope_24>(true);
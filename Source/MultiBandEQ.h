@@ -15,7 +15,10 @@
 #include <memory>
 #include <JuceHeader.h>
 #include "parameterTypes.h"
+#include "ParameterHandle.h"
 #include "EQBand.h"
+#include "BiquadCoefficients.h"
+#include "BiquadCascade.h"
 
 //==============================================================================
 class MultiBandEQ : public juce::dsp::ProcessorBase
@@ -34,15 +37,7 @@ public:
 
 	MultiBandEQ(
 		std::shared_ptr<PluginStateManager> stateManager,
-		// -- HPF
-		ControlID highpassBypassID,
-		ControlID highpassFreqID,
-		ControlID highpassSlopeID,
-		// -- LPF
-		ControlID lowpassBypassID,
-		ControlID lowpassFreqID,
-		ControlID lowpassSlopeID,
-		// -- Band Filters
+		// -- Band Filters, HPF and LPF parameters are fixed
 		EQBandParamIDs bandFilter1ParamIDs,
 		EQBandParamIDs bandFilter2ParamIDs,
 		EQBandParamIDs bandFilter3ParamIDs
@@ -56,27 +51,28 @@ public:
 
 	//==============================================================================
 	float getLatency();
+	MemoryFootprint getMemoryFootprint();
 
 	//==============================================================================
 	void setSampleRate(double sampleRate);
+	void setImplementation(DSPImplementation newImplementation);
 
 private:
 	// TODO: abstract the class from the processor stage of the plugin so that it can be used separately
 	//==============================================================================
 	// --- Object parameters management and information
-	std::shared_ptr<PluginStateManager> stateManager;
+	Param<ControlID::highpassBypass> highpassBypassParam;
+	Param<ControlID::highpassFreq> highpassFreqParam;
+	Param<ControlID::highpassSlope> highpassSlopeParam;
 
-	ControlID highpassBypassID{ ControlID::countParams };
-	ControlID highpassFreqID{ ControlID::countParams };
-	ControlID highpassSlopeID{ ControlID::countParams };
-
-	ControlID lowpassBypassID{ ControlID::countParams };
-	ControlID lowpassFreqID{ ControlID::countParams };
-	ControlID lowpassSlopeID{ ControlID::countParams };
+	Param<ControlID::lowpassBypass> lowpassBypassParam;
+	Param<ControlID::lowpassFreq> lowpassFreqParam;
+	Param<ControlID::lowpassSlope> lowpassSlopeParam;
 
 	//==============================================================================
 	// --- Object member variables
 	double sampleRate{ 0.f };
+	DSPImplementation implementation{ DSPImplementation::Reference };
 
 	enum Slope
 	{
@@ -110,12 +106,25 @@ private:
 	static const int numBands = 3;
 	std::array<EQBand, numBands> bandFilters;
 
+	// -- Optimised: every active section above in one pass, the filters only keep the coefficients
+	enum CascadeSlots
+	{
+		highpassSlots = 0,
+		lowpassSlots = highpassSlots + Slope::countSlopes,
+		bandSlots = lowpassSlots + Slope::countSlopes,
+		//==============================================================================
+		countSlots = bandSlots + numBands
+	};
+	static_assert(CascadeSlots::countSlots <= BiquadCascade::maxSections, "BiquadCascade holds every MultiBandEQ section");
+
+	BiquadCascade cascade;
+
 	//==============================================================================
 	// -- Filters
 	using Coefficients = juce::dsp::IIR::Coefficients<float>;
 
-	juce::ReferenceCountedArray<Coefficients> makeHighpass(double sampleRate);
-	juce::ReferenceCountedArray<Coefficients> makeLowpass(double sampleRate);
+	juce::ReferenceCountedArray<Coefficients> makeHighpass(double sampleRate, const Slope& cutSlope);
+	juce::ReferenceCountedArray<Coefficients> makeLowpass(double sampleRate, const Slope& cutSlope);
 
 	using CoefficientsPtr = Filter::CoefficientsPtr;
 	void updateCoefficients(CoefficientsPtr& old, const CoefficientsPtr& replacements);
@@ -124,10 +133,27 @@ private:
 	void update(PassFilter& filter, const CoefficientType& coefficients);
 
 	template <typename CoefficientType>
-	void updatePassFilter(PassFilter& passFilter, CoefficientType& coefficients, const Slope& cutSlope);
+	void updatePassFilter(PassFilter& passFilter, const CoefficientType& coefficients, const Slope& cutSlope);
+
+	// -- Optimised designs each Butterworth section in place, Reference allocates the whole cascade
+	template <int Index>
+	void designSection(PassFilter& passFilter, bool isHighpass, float freq, int order);
+
+	void designPassFilter(PassFilter& passFilter, bool isHighpass, float freq, const Slope& cutSlope);
+
+	void updateHighpassFilter();
+	void updateLowpassFilter();
+
+	size_t getPassFilterBytes(PassFilter& passFilter);
+
+	template <int Index>
+	void addCascadeSection(PassFilter& passFilter, int firstSlot);
+
+	void addCascadeSections(PassFilter& passFilter, int firstSlot);
 
 	//==============================================================================
 	void preProcess();
+	void processCascade(const juce::dsp::ProcessContextReplacing<float>& context);
 
 	void postUpdateHighpassFilter();
 	void postUpdateLowpassFilter();
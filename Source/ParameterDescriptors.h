@@ -0,0 +1,353 @@
+/*
+  ==============================================================================
+
+	ParameterDescriptors.h
+	Compile-time description of every plugin parameter, one entry per ControlID
+
+	PluginStateManager builds the APVTS layout, the parameter objects and the
+	smoother pools from this table. Everything that does not need a juce object
+	(types, smoothing, pool indexes) is resolved here at compile time.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "parameterTypes.h"
+
+//==============================================================================
+struct ParameterRange
+{
+	float start;
+	float end;
+	float interval;
+	float skew;
+};
+
+struct ParameterChoices
+{
+	const char* const* items;
+	int numItems;
+};
+
+// -- ControlIDs [firstID, endID) of one stage
+struct ParameterGroup
+{
+	ControlID firstID;
+	ControlID endID;
+	ControlID bypassID; // -- ControlID::countParams when the stage cannot be bypassed as a whole
+};
+
+struct ParameterDescriptor
+{
+	ControlID controlID;
+	const char* id;
+	int versionHint;
+	const char* name;
+	ParameterType type;
+	ParameterRange range;
+	float defaultValue; // -- plain value, choice index for choices
+	ParameterChoices choices;
+	const char* suffixLabel;
+	SmoothingType smoothingType;
+	double rampLengthInSeconds;
+};
+
+namespace ParameterDescriptors
+{
+	//==============================================================================
+	// -- Descriptor builders, same arguments as the old addParam overloads
+	constexpr double defaultRampLengthInSeconds = 0.005f;
+
+	constexpr ParameterDescriptor boolParameter(
+		ControlID controlID,
+		const char* id,
+		int versionHint,
+		const char* name,
+		bool defaultValue = false,
+		const char* suffixLabel = "",
+		SmoothingType smoothingType = SmoothingType::NoSmoothing,
+		double rampLengthInSeconds = defaultRampLengthInSeconds
+	)
+	{
+		return { controlID, id, versionHint, name, ParameterType::Bool, { 0.f, 1.f, 1.f, 1.f }, defaultValue ? 1.f : 0.f, { nullptr, 0 }, suffixLabel, smoothingType, rampLengthInSeconds };
+	}
+
+	template <int numChoices>
+	constexpr ParameterDescriptor choiceParameter(
+		ControlID controlID,
+		const char* id,
+		int versionHint,
+		const char* name,
+		const char* const (&choices)[numChoices],
+		int defaultItemIndex = 0,
+		const char* suffixLabel = "",
+		SmoothingType smoothingType = SmoothingType::NoSmoothing,
+		double rampLengthInSeconds = defaultRampLengthInSeconds
+	)
+	{
+		return { controlID, id, versionHint, name, ParameterType::Choice, { 0.f, static_cast<float>(numChoices - 1), 1.f, 1.f }, static_cast<float>(defaultItemIndex), { choices, numChoices }, suffixLabel, smoothingType, rampLengthInSeconds };
+	}
+
+	constexpr ParameterDescriptor floatParameter(
+		ControlID controlID,
+		const char* id,
+		int versionHint,
+		const char* name,
+		ParameterRange range,
+		float defaultValue = 0.f,
+		const char* suffixLabel = "",
+		SmoothingType smoothingType = SmoothingType::NoSmoothing,
+		double rampLengthInSeconds = defaultRampLengthInSeconds
+	)
+	{
+		return { controlID, id, versionHint, name, ParameterType::Float, range, defaultValue, { nullptr, 0 }, suffixLabel, smoothingType, rampLengthInSeconds };
+	}
+
+	constexpr ParameterDescriptor intParameter(
+		ControlID controlID,
+		const char* id,
+		int versionHint,
+		const char* name,
+		int minValue,
+		int maxValue,
+		int defaultValue = 0,
+		const char* suffixLabel = "",
+		SmoothingType smoothingType = SmoothingType::NoSmoothing,
+		double rampLengthInSeconds = defaultRampLengthInSeconds
+	)
+	{
+		return { controlID, id, versionHint, name, ParameterType::Int, { static_cast<float>(minValue), static_cast<float>(maxValue), 1.f, 1.f }, static_cast<float>(defaultValue), { nullptr, 0 }, suffixLabel, smoothingType, rampLengthInSeconds };
+	}
+
+	//==============================================================================
+	// -- ranges
+	constexpr ParameterRange gainRange{ -24.f, 24.f, .01f, 1.f };
+	constexpr ParameterRange freqRange{ 20.f, 20000.f, 1.f, .198893842f };
+	constexpr ParameterRange filterQRange{ .1f, 10.f, .05f, 1.f };
+	constexpr ParameterRange thresholdRange{ -60.f, 24.f, 1.f, 1.f };
+	constexpr ParameterRange attackReleaseRange{ 5.f, 500.f, 1.f, 1.f };
+	constexpr ParameterRange ratioRange{ 1.f, 100.f, .1f, .4f };
+
+	//==============================================================================
+	// -- choices
+	constexpr const char* freqPassSlopeChoices[]{ "12 db/Oct", "24 db/Oct", "36 db/Oct", "48 db/Oct" };
+	constexpr const char* imagerTypeChoices[]{ "Haas", "Haas - mono cancelation", "Haas - mid/side processing" };
+
+	//==============================================================================
+	// -- Same mapping as juce::NormalisableRange (start, end, interval, skew) without building one
+	inline float convertTo0to1(const ParameterRange& range, float value)
+	{
+		float proportion = std::clamp((value - range.start) / (range.end - range.start), 0.f, 1.f);
+		return range.skew == 1.f ? proportion : std::pow(proportion, range.skew);
+	}
+
+	inline float convertFrom0to1(const ParameterRange& range, float proportion)
+	{
+		proportion = std::clamp(proportion, 0.f, 1.f);
+		if (range.skew != 1.f && proportion > 0.f)
+		{
+			proportion = std::exp(std::log(proportion) / range.skew);
+		}
+		return range.start + (range.end - range.start) * proportion;
+	}
+
+	//==============================================================================
+	// -- Table, indexed by ControlID
+	constexpr std::array<ParameterDescriptor, ControlID::countParams> table{ {
+		//==============================================================================
+		// -- Bypass ALL
+		boolParameter(ControlID::bypass, "bypass", V1_0_0, "bypass", false, "", SmoothingType::Linear, .01f),
+		// -- Blend (dry/wet)
+		floatParameter(ControlID::blend, "blend", V1_0_0, "blend", { 0.f, 1.f, .01f, 1.f }, 1.f, "", SmoothingType::Linear),
+		// -- Pre Gain
+		floatParameter(ControlID::preGain, "preGain", V1_0_0, "pre-gain", gainRange, 0.f, "dB", SmoothingType::NoSmoothing), // -- Gain DSP module already has smoothing
+		//==============================================================================
+		// -- Multi Band EQ -- HPF, LPF, 3 Band
+		// -- HPF
+		boolParameter(ControlID::highpassBypass, "highpassBypass", V1_0_0, "hpf bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::highpassFreq, "highpassFreq", V1_0_0, "hpf freq", freqRange, 20.f, "Hz", SmoothingType::Linear),
+		choiceParameter(ControlID::highpassSlope, "highpassSlope", V1_0_0, "hpf slope", freqPassSlopeChoices),
+		// -- LPF
+		boolParameter(ControlID::lowpassBypass, "lowpassBypass", V1_0_0, "lpf bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::lowpassFreq, "lowpassFreq", V1_0_0, "lpf freq", freqRange, 20000.f, "Hz", SmoothingType::Linear),
+		choiceParameter(ControlID::lowpassSlope, "lowpassSlope", V1_0_0, "lpf slope", freqPassSlopeChoices),
+		// -- Band Filter 1
+		boolParameter(ControlID::bandFilter1Bypass, "bandFilter1Bypass", V1_0_0, "bpf1 bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::bandFilter1PeakFreq, "bandFilter1PeakFreq", V1_0_0, "bpf1 freq", freqRange, 750.f, "Hz", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter1PeakGain, "bandFilter1PeakGain", V1_0_0, "bpf1 gain", gainRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter1PeakQ, "bandFilter1PeakQ", V1_0_0, "bpf1 Q", filterQRange, 1.f, "", SmoothingType::Linear),
+		// -- Band Filter 2
+		boolParameter(ControlID::bandFilter2Bypass, "bandFilter2Bypass", V1_0_0, "bpf2 bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::bandFilter2PeakFreq, "bandFilter2PeakFreq", V1_0_0, "bpf2 freq", freqRange, 2000.f, "Hz", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter2PeakGain, "bandFilter2PeakGain", V1_0_0, "bpf2 gain", gainRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter2PeakQ, "bandFilter2PeakQ", V1_0_0, "bpf2 Q", filterQRange, 1.f, "", SmoothingType::Linear),
+		// -- Band Filter 3
+		boolParameter(ControlID::bandFilter3Bypass, "bandFilter3Bypass", V1_0_0, "bpf3 bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::bandFilter3PeakFreq, "bandFilter3PeakFreq", V1_0_0, "bpf3 freq", freqRange, 4000.f, "Hz", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter3PeakGain, "bandFilter3PeakGain", V1_0_0, "bpf3 gain", gainRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::bandFilter3PeakQ, "bandFilter3PeakQ", V1_0_0, "bpf3 Q", filterQRange, 1.f, "", SmoothingType::Linear),
+		//==============================================================================
+		boolParameter(ControlID::compressorBypass, "compressorBypass", V1_0_0, "compressor bypass", false, "", SmoothingType::Linear, .01f),
+		// -- Multi Band Compressor
+		floatParameter(ControlID::lowMidCrossoverFreq, "lowMidCrossoverFreq", V1_0_0, "low-mid crossover freq", { 20.f, 999.f, 1.f, .198893842f }, 400.f, "Hz", SmoothingType::Linear),
+		floatParameter(ControlID::midHighCrossoverFreq, "midHighCrossoverFreq", V1_0_0, "mid-high crossover freq", { 1000.f, 20000.f, 1.f, .198893842f }, 2000.f, "Hz", SmoothingType::Linear),
+		// -- Low Band Compressor
+		boolParameter(ControlID::lowBandCompressorMute, "lowBandCompressorMute", V1_0_0, "low band mute", false, "", SmoothingType::Linear, .01f),
+		boolParameter(ControlID::lowBandCompressorBypass, "lowBandCompressorBypass", V1_0_0, "low band bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::lowBandCompressorThreshold, "lowBandCompressorThreshold", V1_0_0, "low band threshold", thresholdRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::lowBandCompressorAttack, "lowBandCompressorAttack", V1_0_0, "low band attack", attackReleaseRange, 50.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::lowBandCompressorRelease, "lowBandCompressorRelease", V1_0_0, "low band release", attackReleaseRange, 250.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::lowBandCompressorRatio, "lowBandCompressorRatio", V1_0_0, "low band ratio", ratioRange, 1.f, "", SmoothingType::Linear),
+		// -- Mid Band Compressor
+		boolParameter(ControlID::midBandCompressorMute, "midBandCompressorMute", V1_0_0, "mid band mute", false, "", SmoothingType::Linear, .01f),
+		boolParameter(ControlID::midBandCompressorBypass, "midBandCompressorBypass", V1_0_0, "mid band bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::midBandCompressorThreshold, "midBandCompressorThreshold", V1_0_0, "mid band threshold", thresholdRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::midBandCompressorAttack, "midBandCompressorAttack", V1_0_0, "mid band attack", attackReleaseRange, 50.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::midBandCompressorRelease, "midBandCompressorRelease", V1_0_0, "mid band release", attackReleaseRange, 250.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::midBandCompressorRatio, "midBandCompressorRatio", V1_0_0, "mid band ratio", ratioRange, 1.f, "", SmoothingType::Linear),
+		// -- High Band Compressor
+		boolParameter(ControlID::highBandCompressorMute, "highBandCompressorMute", V1_0_0, "high band mute", false, "", SmoothingType::Linear, .01f),
+		boolParameter(ControlID::highBandCompressorBypass, "highBandCompressorBypass", V1_0_0, "high band bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::highBandCompressorThreshold, "highBandCompressorThreshold", V1_0_0, "high band threshold", thresholdRange, 0.f, "dB", SmoothingType::Linear),
+		floatParameter(ControlID::highBandCompressorAttack, "highBandCompressorAttack", V1_0_0, "high band attack", attackReleaseRange, 50.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::highBandCompressorRelease, "highBandCompressorRelease", V1_0_0, "high band release", attackReleaseRange, 250.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::highBandCompressorRatio, "highBandCompressorRatio", V1_0_0, "high band ratio", ratioRange, 1.f, "", SmoothingType::Linear),
+		//==============================================================================
+		// -- Imager
+		boolParameter(ControlID::imagerBypass, "imagerBypass", V1_0_0, "imager bypass", false, "", SmoothingType::Linear, .01f),
+		floatParameter(ControlID::imagerOriginalGain, "imagerOriginalGain", V1_0_0, "imager original gain", { 0.f, 2.f, .001f, 1.f }, 1.f, "", SmoothingType::Linear),
+		floatParameter(ControlID::imagerAuxiliarGain, "imagerAuxiliarGain", V1_0_0, "imager aux gain", { 0.f, 2.f, .001f, 1.f }, 1.f, "", SmoothingType::Linear),
+		floatParameter(ControlID::imagerWidth, "imagerWidth", V1_0_0, "imager width", { -1.f, 1.f, .001f, 1.f }, .5f, "", SmoothingType::Linear),
+		floatParameter(ControlID::imagerCenter, "imagerCenter", V1_0_0, "imager center", { -1.f, 1.f, .001f, 1.f }, 0.f, "", SmoothingType::Linear),
+		floatParameter(ControlID::imagerDelayTime, "imagerDelayTime", V1_0_0, "imager delay time", { 0.f, 50.f, .001f, .7f }, 4.f, "ms", SmoothingType::Linear),
+		floatParameter(ControlID::imagerCrossoverFreq, "imagerCrossoverFreq", V1_0_0, "imager crossover freq", freqRange, 300.f, "Hz", SmoothingType::Linear),
+		choiceParameter(ControlID::imagerType, "imagerType", V1_0_0, "imager type", imagerTypeChoices),
+		//==============================================================================
+		// -- Phaser
+		boolParameter(ControlID::phaserBypass, "phaserBypass", V1_0_0, "phaser bypass", false, "", SmoothingType::Linear, 0.01f),
+		// -- Phaser LFO
+		// -- LFO rate -- (0, 100) Hz
+		floatParameter(ControlID::phaserRate, "phaserRate", V1_0_0, "phaser rate", { 0.f, 99.999f, .001f, .35f }, 1.f, "", SmoothingType::Linear), // TODO: check skew factor
+		// -- LFO depth -- (0, 1)
+		floatParameter(ControlID::phaserDepth, "phaserDepth", V1_0_0, "phaser depth", { 0.f, 1.f, .001f, .5f }, .5f, "", SmoothingType::Linear),
+		// -- Phaser Filter -- Centre Frequency -- (20, 20000) Hz
+		floatParameter(ControlID::phaserCentreFrequency, "phaserCentreFrequency", V1_0_0, "phaser center freq", freqRange, 1300.f, "Hz", SmoothingType::Linear),
+		// -- Phaser other params
+		// -- Feedback -- (-1, 1)
+		floatParameter(ControlID::phaserFeedback, "phaserFeedback", V1_0_0, "phaser feedback", { -1.f, 1.f, 0.01f, 1.f }, 0.f, "", SmoothingType::Linear),
+		// -- Mix -- (0, 1)
+		floatParameter(ControlID::phaserMix, "phaserMix", V1_0_0, "phaser mix", { 0.f, 1.f, .01f, 1.f }, .5f, "", SmoothingType::Linear),
+	} };
+
+	//==============================================================================
+	constexpr const ParameterDescriptor& get(ControlID controlID)
+	{
+		return table[controlID];
+	}
+
+	constexpr bool isIndexedByControlID()
+	{
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			if (table[i].controlID != i)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	static_assert(isIndexedByControlID(), "ParameterDescriptors::table entries must follow the ControlID order");
+
+	//==============================================================================
+	// -- Smoother pools, sized and indexed at compile time
+	constexpr int countSmoothed(SmoothingType smoothingType)
+	{
+		int count{ 0 };
+		for (const auto& descriptor : table)
+		{
+			count += descriptor.smoothingType == smoothingType ? 1 : 0;
+		}
+		return count;
+	}
+
+	constexpr int numLinearSmoothed = countSmoothed(SmoothingType::Linear);
+	constexpr int numMultiplicativeSmoothed = countSmoothed(SmoothingType::Multiplicative);
+
+	// -- ControlID -> index in its pool, -1 when not smoothed
+	constexpr std::array<int, ControlID::countParams> makeSmoothingIndexes()
+	{
+		std::array<int, ControlID::countParams> indexes{};
+		int numLinear{ 0 };
+		int numMultiplicative{ 0 };
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			switch (table[i].smoothingType)
+			{
+			case SmoothingType::Linear:
+				indexes[i] = numLinear++;
+				break;
+			case SmoothingType::Multiplicative:
+				indexes[i] = numMultiplicative++;
+				break;
+			default:
+				indexes[i] = -1;
+			}
+		}
+		return indexes;
+	}
+
+	constexpr std::array<int, ControlID::countParams> smoothingIndexes = makeSmoothingIndexes();
+
+	// -- pool index -> ControlID
+	template <int poolSize>
+	constexpr std::array<ControlID, poolSize> makeSmoothedControlIDs(SmoothingType smoothingType)
+	{
+		std::array<ControlID, poolSize> controlIDs{};
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			if (table[i].smoothingType == smoothingType)
+			{
+				controlIDs[smoothingIndexes[i]] = intToEnum(i, ControlID);
+			}
+		}
+		return controlIDs;
+	}
+
+	constexpr std::array<ControlID, numLinearSmoothed> linearSmoothedControlIDs = makeSmoothedControlIDs<numLinearSmoothed>(SmoothingType::Linear);
+	constexpr std::array<ControlID, numMultiplicativeSmoothed> multiplicativeSmoothedControlIDs = makeSmoothedControlIDs<numMultiplicativeSmoothed>(SmoothingType::Multiplicative);
+
+	//==============================================================================
+	// -- Stage groups -- while its bypass is on, only the bypass of a group is synced
+	constexpr std::array<ParameterGroup, ParameterGroupID::countGroups> groups{ {
+		// -- the blend mixer fades the general bypass, it never stops syncing
+		{ ControlID::bypass, ControlID::highpassBypass, ControlID::countParams },
+		// -- every EQ filter has its own bypass
+		{ ControlID::highpassBypass, ControlID::compressorBypass, ControlID::countParams },
+		{ ControlID::compressorBypass, ControlID::imagerBypass, ControlID::compressorBypass },
+		{ ControlID::imagerBypass, ControlID::phaserBypass, ControlID::imagerBypass },
+		{ ControlID::phaserBypass, ControlID::countParams, ControlID::phaserBypass },
+	} };
+
+	constexpr bool groupsCoverEveryControlID()
+	{
+		int nextID{ 0 };
+		for (const auto& group : groups)
+		{
+			if (group.firstID != nextID || group.endID <= group.firstID)
+			{
+				return false;
+			}
+			if (group.bypassID != ControlID::countParams && (group.bypassID < group.firstID || group.bypassID >= group.endID || table[group.bypassID].type != ParameterType::Bool))
+			{
+				return false;
+			}
+			nextID = group.endID;
+		}
+		return nextID == ControlID::countParams;
+	}
+	static_assert(groupsCoverEveryControlID(), "ParameterDescriptors::groups must split the ControlIDs in order, bypasses must be bool parameters of their group");
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+	ParameterHandle.h
+	Direct read access to one parameter of a PluginStateManager
+
+	A handle resolves its ControlID once, at construction, to the manager's cache slot
+	and ParameterObject, so a per-block read is a single load instead of going through
+	the manager. Stages whose ControlIDs are constructor arguments (the EQ and compressor
+	bands share their classes) hold ParameterHandle, fixed parameters use Param<id>, which
+	also exposes the descriptor at compile time.
+	The manager must outlive its handles.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "parameterTypes.h"
+#include "ParameterObject.h"
+#include "ParameterDescriptors.h"
+#include "PluginStateManager.h"
+
+//==============================================================================
+class ParameterHandle
+{
+public:
+	//==============================================================================
+	ParameterHandle() = default;
+	ParameterHandle(PluginStateManager& stateManager, ControlID controlID) :
+		stateManager(&stateManager),
+		controlID(controlID),
+		currentValue(stateManager.getCurrentValueSlot(controlID)),
+		parameterObject(&stateManager.getParameterObject(controlID))
+	{
+	}
+
+	//==============================================================================
+	ControlID getControlID() const
+	{
+		return controlID;
+	}
+
+	const ParameterDescriptor& getDescriptor() const
+	{
+		return ParameterDescriptors::get(controlID);
+	}
+
+	juce::NormalisableRange<float> getParameterRange() const
+	{
+		return parameterObject->getParameterRange();
+	}
+
+	//==============================================================================
+	// -- Current value of the block, plain units (PluginStateManager::getCurrentValue)
+	float get() const
+	{
+		jassert(currentValue != nullptr);
+		return *currentValue;
+	}
+
+	// -- Inbound value read at the last sync (PluginStateManager::getFloatValue), for prepare
+	float getInBound() const
+	{
+		return parameterObject->getFloatValue();
+	}
+
+	bool getBool() const
+	{
+		return parameterObject->getBoolValue();
+	}
+
+	int getChoiceIndex() const
+	{
+		return parameterObject->getChoiceIndex();
+	}
+
+	// -- Per-sample values of the current block (PluginStateManager::getSmoothedBlock)
+	const float* getSmoothedBlock(int numSamples) const
+	{
+		return stateManager->getSmoothedBlock(controlID, numSamples);
+	}
+
+	int getSmoothedBlockCapacity() const
+	{
+		return stateManager->getSmoothedBlockCapacity();
+	}
+
+private:
+	//==============================================================================
+	PluginStateManager* stateManager{ nullptr };
+	ControlID controlID{ ControlID::countParams };
+	const float* currentValue{ nullptr };
+	ParameterObject* parameterObject{ nullptr };
+};
+
+//==============================================================================
+template <ControlID id>
+class Param : public ParameterHandle
+{
+public:
+	static constexpr ParameterDescriptor descriptor = ParameterDescriptors::get(id);
+	static constexpr ParameterType parameterType = descriptor.type;
+	static constexpr SmoothingType smoothingType = descriptor.smoothingType;
+
+	//==============================================================================
+	Param() = default;
+	explicit Param(PluginStateManager& stateManager) :
+		ParameterHandle(stateManager, id)
+	{
+	}
+};
@@ -11,13 +11,15 @@
 //==============================================================================
 ParameterObject::ParameterObject() :
 	parameter(nullptr),
-	parameterType(ParameterType::Float)
+	parameterType(ParameterType::Float),
+	rawParameterValue(nullptr)
 {
 }
 
-ParameterObject::ParameterObject(juce::RangedAudioParameter* parameter, ParameterType parameterType) :
+ParameterObject::ParameterObject(juce::RangedAudioParameter* parameter, ParameterType parameterType, std::atomic<float>* rawParameterValue) :
 	parameter(parameter),
-	parameterType(parameterType)
+	parameterType(parameterType),
+	rawParameterValue(rawParameterValue)
 {
 	// -- Update the inBound variables to initialize them
 	updateInBoundVariable();
@@ -31,6 +33,7 @@ ParameterObject::~ParameterObject()
 ParameterObject::ParameterObject(const ParameterObject& other) : // copy constructor
 	parameter(other.parameter),
 	parameterType(other.parameterType),
+	rawParameterValue(other.rawParameterValue),
 	inBoundVariable(other.inBoundVariable.load(std::memory_order_relaxed))
 {
 }
@@ -38,6 +41,7 @@ ParameterObject::ParameterObject(const ParameterObject& other) : // copy constru
 ParameterObject::ParameterObject(ParameterObject&& other) noexcept : // move constructor
 	parameter(std::exchange(other.parameter, nullptr)),
 	parameterType(other.parameterType),
+	rawParameterValue(std::exchange(other.rawParameterValue, nullptr)),
 	inBoundVariable(other.inBoundVariable.load(std::memory_order_relaxed))
 {
 }
@@ -52,6 +56,7 @@ ParameterObject& ParameterObject::operator=(const ParameterObject& other) // cop
 	// -- Parameter data
 	parameter = other.parameter;
 	parameterType = other.parameterType;
+	rawParameterValue = other.rawParameterValue;
 	// -- InBound value
 	inBoundVariable = other.inBoundVariable.load(std::memory_order_relaxed);
 
@@ -67,6 +72,7 @@ ParameterObject& ParameterObject::operator=(ParameterObject&& other) noexcept //
 	// -- Parameter data
 	std::swap(parameterType, other.parameterType);
 	std::swap(parameter, other.parameter);
+	std::swap(rawParameterValue, other.rawParameterValue);
 	// -- InBound value
 	float tempInBoundVariable = inBoundVariable.load(std::memory_order_relaxed);
 	inBoundVariable = other.inBoundVariable.load(std::memory_order_relaxed);
@@ -157,21 +163,34 @@ int ParameterObject::getIntValue()
 //==============================================================================
 float ParameterObject::updateInBoundVariable()
 {
-	// -- Update the inBound variable
+	if (rawParameterValue == nullptr)
+	{
+		// -- not attached to an APVTS, ask the parameter itself
+		inBoundVariable = parameter->convertFrom0to1(parameter->getValue());
+		return getInBoundVariable();
+	}
+
+	// -- Update the inBound variable, the raw value is already denormalised
+	float rawValue = rawParameterValue->load(std::memory_order_relaxed);
 	switch (parameterType)
 	{
 	case ParameterType::Bool:
-		inBoundVariable = static_cast<float>(getParameterBool()->get());
+		inBoundVariable = rawValue >= 0.5f ? 1.f : 0.f;
 		break;
 	case ParameterType::Choice:
-		inBoundVariable = static_cast<float>(getParameterChoice()->getIndex());
-		break;
 	case ParameterType::Int:
-		inBoundVariable = static_cast<float>(getParameterInt()->get());
+		inBoundVariable = static_cast<float>(juce::roundToInt(rawValue));
 		break;
 	case ParameterType::Float:
-		inBoundVariable = getParameterFloat()->get();
+		inBoundVariable = rawValue;
 	}
 
 	return getInBoundVariable();
 }
+
+float ParameterObject::setInBoundVariable(float newValue)
+{
+	inBoundVariable = newValue;
+
+	return getInBoundVariable();
+}
@@ -12,14 +12,6 @@
 #include <JuceHeader.h>
 #include "parameterTypes.h"
 
-enum class ParameterType
-{
-	Bool,
-	Choice,
-	Float,
-	Int
-};
-
 class ParameterObject
 {
 public:
@@ -28,7 +20,8 @@ public:
 	ParameterObject();
 	ParameterObject(
 		juce::RangedAudioParameter* parameter,
-		ParameterType parameterType = ParameterType::Float
+		ParameterType parameterType = ParameterType::Float,
+		std::atomic<float>* rawParameterValue = nullptr // -- APVTS::getRawParameterValue, read on the audio thread instead of the parameter
 	);
 	~ParameterObject();
 
@@ -66,12 +59,15 @@ public:
 
 	//==============================================================================
 	float updateInBoundVariable();
+	float setInBoundVariable(float newValue); // -- bypasses the parameter, used to replay recorded automation
 
 private:
 	//==============================================================================
 	// -- Parameter data
 	ParameterType parameterType;
 	juce::RangedAudioParameter* parameter;
+	// -- Denormalised value, cached at attach time so syncing is a plain atomic load
+	std::atomic<float>* rawParameterValue;
 	//==============================================================================
 	// -- InBound value
 	std::atomic<float> inBoundVariable;
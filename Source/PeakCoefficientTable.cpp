@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+	PeakCoefficientTable.cpp
+
+  ==============================================================================
+*/
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include "PeakCoefficientTable.h"
+#include "BiquadCoefficients.h"
+
+//==============================================================================
+PeakCoefficientTable::PeakCoefficientTable(double sampleRate) :
+	sampleRate(sampleRate)
+{
+	jassert(sampleRate > 0.0);
+
+	// -- Frequency -- up to Nyquist at low sample rates, one entry past the top so every lookup has an upper neighbour
+	topFrequency = static_cast<float>(juce::jmin(static_cast<double>(maxFrequency), sampleRate * 0.5));
+	const juce::uint32 fractionMask = (1u << fractionBits) - 1;
+	firstFrequencyBits = toBits(minFrequency) & ~fractionMask;
+
+	const size_t numFrequencyEntries = static_cast<size_t>((toBits(topFrequency) - firstFrequencyBits) >> fractionBits) + 2;
+	frequencyEntries.resize(numFrequencyEntries);
+	for (size_t i{ 0 }; i < numFrequencyEntries; ++i)
+	{
+		const double frequency = fromBits(firstFrequencyBits + (static_cast<juce::uint32>(i) << fractionBits));
+		const double omega = 2.0 * juce::MathConstants<double>::pi * frequency / sampleRate;
+		frequencyEntries[i] = { static_cast<float>(std::sin(omega)), static_cast<float>(std::cos(omega)) };
+	}
+
+	// -- Gain -- uniform in dB, one entry past the top as well
+	const size_t numGainEntries = static_cast<size_t>((maxGainDecibels - minGainDecibels) * stepsPerDecibel) + 2;
+	gainEntries.resize(numGainEntries);
+	for (size_t i{ 0 }; i < numGainEntries; ++i)
+	{
+		const double gainDecibels = minGainDecibels + static_cast<double>(i) / stepsPerDecibel;
+		const double amplitude = std::pow(10.0, gainDecibels / 40.0);
+		gainEntries[i] = { static_cast<float>(amplitude), static_cast<float>(1.0 / amplitude) };
+	}
+}
+
+PeakCoefficientTable::~PeakCoefficientTable()
+{
+}
+
+std::shared_ptr<const PeakCoefficientTable> PeakCoefficientTable::getShared(double sampleRate)
+{
+	// -- Weak references: a table lives while some instance prepared at its sample rate holds it
+	static juce::CriticalSection lock;
+	static std::map<double, std::weak_ptr<const PeakCoefficientTable>> tables;
+
+	const juce::ScopedLock scopedLock(lock);
+	auto& entry = tables[sampleRate];
+	auto table = entry.lock();
+	if (table == nullptr)
+	{
+		table = std::make_shared<const PeakCoefficientTable>(sampleRate);
+		entry = table;
+	}
+	return table;
+}
+
+//==============================================================================
+double PeakCoefficientTable::getSampleRate() const
+{
+	return sampleRate;
+}
+
+size_t PeakCoefficientTable::getBytes() const
+{
+	return frequencyEntries.size() * sizeof(FrequencyEntry) + gainEntries.size() * sizeof(GainEntry);
+}
+
+void PeakCoefficientTable::makePeakFilter(juce::dsp::IIR::Coefficients<float>& target, float frequency, float Q, float gainDecibels) const
+{
+	jassert(Q > 0.f);
+
+	// -- Frequency -- entry from the exponent and top mantissa bits, fraction from the rest
+	const juce::uint32 frequencyOffset = toBits(juce::jlimit(minFrequency, topFrequency, frequency)) - firstFrequencyBits;
+	const size_t frequencyIndex = frequencyOffset >> fractionBits;
+	const float frequencyFraction = static_cast<float>(frequencyOffset & ((1u << fractionBits) - 1)) * (1.f / static_cast<float>(1u << fractionBits));
+	const auto& lowerFrequency = frequencyEntries[frequencyIndex];
+	const auto& upperFrequency = frequencyEntries[frequencyIndex + 1];
+	const float sinOmega = lowerFrequency.sinOmega + frequencyFraction * (upperFrequency.sinOmega - lowerFrequency.sinOmega);
+	const float cosOmega = lowerFrequency.cosOmega + frequencyFraction * (upperFrequency.cosOmega - lowerFrequency.cosOmega);
+
+	// -- Gain
+	const float gainPosition = (juce::jlimit(minGainDecibels, maxGainDecibels, gainDecibels) - minGainDecibels) * stepsPerDecibel;
+	const size_t gainIndex = static_cast<size_t>(gainPosition);
+	const float gainFraction = gainPosition - static_cast<float>(gainIndex);
+	const auto& lowerGain = gainEntries[gainIndex];
+	const auto& upperGain = gainEntries[gainIndex + 1];
+	const float A = lowerGain.amplitude + gainFraction * (upperGain.amplitude - lowerGain.amplitude);
+	const float inverseA = lowerGain.inverseAmplitude + gainFraction * (upperGain.inverseAmplitude - lowerGain.inverseAmplitude);
+
+	// -- Same products as IIR::Coefficients::makePeakFilter
+	const auto alpha = sinOmega / (Q * 2);
+	const auto c2 = -2 * cosOmega;
+	const auto alphaTimesA = alpha * A;
+	const auto alphaOverA = alpha * inverseA;
+
+	BiquadCoefficients::assign(target, 1 + alphaTimesA, c2, 1 - alphaTimesA, 1 + alphaOverA, c2, 1 - alphaOverA);
+}
+
+//==============================================================================
+juce::uint32 PeakCoefficientTable::toBits(float value)
+{
+	juce::uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+float PeakCoefficientTable::fromBits(juce::uint32 bits)
+{
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+	PeakCoefficientTable.h
+	Shared lookup tables for peak filter designs, one per sample rate
+
+	A peak biquad only needs sin/cos of the centre frequency and sqrt of the linear gain;
+	Q enters through a division. Instead of a frequency x gain x Q grid of coefficients,
+	which would cost megabytes and three-way interpolation, the table keeps the two one
+	dimensional parts: sin/cos over the freq parameter range and the amplitude (and its
+	inverse) over the gain range. A design is then two interpolated reads plus the usual
+	few products, no sin/cos/pow/log.
+
+	The frequency grid is indexed straight from the float bits: exponent and top mantissa
+	bits pick the entry, the remaining mantissa bits are the interpolation fraction. That
+	gives stepsPerOctave evenly spaced entries per octave without computing a log.
+
+	Built on first request for a sample rate (message thread, from prepare) and shared
+	by every instance in the process while one of them holds it. Lookups are const and
+	lock free, safe from any number of audio threads.
+
+	Opt in, not part of the shipped plugin: only compiled in with
+	TALKINGHEADS_PEAK_COEFFICIENT_TABLE=1 (CMake option, OFF), and then only used by
+	Optimised EQ bands. The default build keeps the exact in place design, so Optimised
+	gives the same coefficients as Reference. With the table a design takes about 2/3 of
+	the time of the direct one and its coefficients differ by up to ~6e-6 at 48 kHz
+	(~3.5e-6 at 96 kHz). To check a build with it:
+		cmake -DTALKINGHEADS_PEAK_COEFFICIENT_TABLE=ON ...
+		talkingheads_equivalence --processor EQBand
+		talkingheads_bench_processors --processor EQBand --implementation optimised
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TALKINGHEADS_PEAK_COEFFICIENT_TABLE
+#define TALKINGHEADS_PEAK_COEFFICIENT_TABLE 0
+#endif
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "ParameterDescriptors.h"
+
+//==============================================================================
+class PeakCoefficientTable
+{
+public:
+	//==============================================================================
+	static constexpr float minFrequency{ ParameterDescriptors::freqRange.start };
+	static constexpr float maxFrequency{ ParameterDescriptors::freqRange.end };
+	static constexpr int octaveBits{ 9 }; // -- top mantissa bits used as index
+	static constexpr int stepsPerOctave{ 1 << octaveBits };
+
+	static constexpr float minGainDecibels{ ParameterDescriptors::gainRange.start };
+	static constexpr float maxGainDecibels{ ParameterDescriptors::gainRange.end };
+	static constexpr int stepsPerDecibel{ 20 };
+
+	//==============================================================================
+	explicit PeakCoefficientTable(double sampleRate);
+	~PeakCoefficientTable();
+
+	// -- Message thread, builds the table the first time a sample rate is asked for
+	static std::shared_ptr<const PeakCoefficientTable> getShared(double sampleRate);
+
+	//==============================================================================
+	double getSampleRate() const;
+	size_t getBytes() const;
+
+	// -- Same design as IIR::Coefficients::makePeakFilter, frequency and gain clamped to the tables
+	void makePeakFilter(juce::dsp::IIR::Coefficients<float>& target, float frequency, float Q, float gainDecibels) const;
+
+private:
+	//==============================================================================
+	struct FrequencyEntry
+	{
+		float sinOmega;
+		float cosOmega;
+	};
+
+	struct GainEntry
+	{
+		float amplitude; // -- sqrt of the linear gain
+		float inverseAmplitude;
+	};
+
+	static constexpr int mantissaBits{ 23 };
+	static constexpr int fractionBits{ mantissaBits - octaveBits };
+
+	double sampleRate;
+	float topFrequency;
+	juce::uint32 firstFrequencyBits; // -- minFrequency rounded down to the grid
+	std::vector<FrequencyEntry> frequencyEntries;
+	std::vector<GainEntry> gainEntries;
+
+	//==============================================================================
+	static juce::uint32 toBits(float value);
+	static float fromBits(juce::uint32 bits);
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(PeakCoefficientTable)
+};
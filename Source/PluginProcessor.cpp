@@ -16,9 +16,18 @@ TalkingHeadsPluginAudioProcessor::TalkingHeadsPluginAudioProcessor() :
 		.withInput("Input", juce::AudioChannelSet::mono(), true)
 		.withOutput("Output", juce::AudioChannelSet::stereo(), true)
 	),
-	stateManager(std::make_shared<PluginStateManager>(
-		PluginStateManager(*this, nullptr, juce::Identifier(APVTS_ID))
-	)),
+	stateManager(std::make_shared<PluginStateManager>(*this, nullptr, juce::Identifier(APVTS_ID))),
+	// -- General parameters
+	bypassParam(*stateManager),
+	blendParam(*stateManager),
+	preGainParam(*stateManager),
+	// -- Phaser
+	phaserBypassParam(*stateManager),
+	phaserRateParam(*stateManager),
+	phaserDepthParam(*stateManager),
+	phaserCentreFrequencyParam(*stateManager),
+	phaserFeedbackParam(*stateManager),
+	phaserMixParam(*stateManager),
 	multiBandCompressor(
 		stateManager,
 		ControlID::compressorBypass,
@@ -53,14 +62,6 @@ TalkingHeadsPluginAudioProcessor::TalkingHeadsPluginAudioProcessor() :
 	),
 	multiBandEQ(
 		stateManager,
-		// -- HPF
-		ControlID::highpassBypass,
-		ControlID::highpassFreq,
-		ControlID::highpassSlope,
-		// -- LPF
-		ControlID::lowpassBypass,
-		ControlID::lowpassFreq,
-		ControlID::lowpassSlope,
 		// -- Band Filters
 		{
 			ControlID::bandFilter1Bypass,
@@ -81,17 +82,7 @@ TalkingHeadsPluginAudioProcessor::TalkingHeadsPluginAudioProcessor() :
 			ControlID::bandFilter3PeakQ
 		}
 	),
-	imager(
-		stateManager,
-		ControlID::imagerBypass,
-		ControlID::imagerOriginalGain,
-		ControlID::imagerAuxiliarGain,
-		ControlID::imagerWidth,
-		ControlID::imagerCenter,
-		ControlID::imagerDelayTime,
-		ControlID::imagerCrossoverFreq,
-		ControlID::imagerType
-	)
+	imager(stateManager)
 {
 }
 
@@ -139,26 +130,75 @@ double TalkingHeadsPluginAudioProcessor::getTailLengthSeconds() const
 
 int TalkingHeadsPluginAudioProcessor::getNumPrograms()
 {
-	return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-	// so this should be at least 1, even if you're not really implementing programs.
+	return presetBank.getNumPresets();   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+	// so this should be at least 1, the bank always keeps one.
 }
 
 int TalkingHeadsPluginAudioProcessor::getCurrentProgram()
 {
-	return 0;
+	return currentProgram;
 }
 
 void TalkingHeadsPluginAudioProcessor::setCurrentProgram(int index)
 {
+	if (!presetBank.isValidIndex(index))
+	{
+		return;
+	}
+
+	currentProgram = index;
+	// -- the audio thread picks the whole preset up in one block and ramps to it
+	stateManager->restoreParameterValues(presetBank.getValues(index), programMorphTimeInSeconds);
 }
 
 const juce::String TalkingHeadsPluginAudioProcessor::getProgramName(int index)
 {
-	return {};
+	return presetBank.isValidIndex(index) ? presetBank.getName(index) : juce::String();
 }
 
 void TalkingHeadsPluginAudioProcessor::changeProgramName(int index, const juce::String& newName)
 {
+	if (presetBank.isValidIndex(index))
+	{
+		presetBank.setName(index, newName);
+		updateHostDisplay(ChangeDetails().withProgramChanged(true));
+	}
+}
+
+//==============================================================================
+const PresetBank& TalkingHeadsPluginAudioProcessor::getPresetBank() const
+{
+	return presetBank;
+}
+
+int TalkingHeadsPluginAudioProcessor::storeProgram(const juce::String& name)
+{
+	const int index = presetBank.addPreset(name, stateManager->getParameterValues());
+	updateHostDisplay(ChangeDetails().withProgramChanged(true));
+	return index;
+}
+
+void TalkingHeadsPluginAudioProcessor::removeProgram(int index)
+{
+	const int numPresets = presetBank.getNumPresets();
+	presetBank.removePreset(index);
+	if (presetBank.getNumPresets() == numPresets)
+	{
+		return; // -- invalid index or the last program
+	}
+
+	// -- programs after the removed one move down, removing the current one leaves its neighbour selected
+	if (index < currentProgram)
+	{
+		--currentProgram;
+	}
+	currentProgram = juce::jmin(currentProgram, presetBank.getNumPresets() - 1);
+	updateHostDisplay(ChangeDetails().withProgramChanged(true));
+}
+
+void TalkingHeadsPluginAudioProcessor::setProgramMorphTime(double newMorphTimeInSeconds)
+{
+	programMorphTimeInSeconds = juce::jmax(0.0, newMorphTimeInSeconds);
 }
 
 //==============================================================================
@@ -178,17 +218,20 @@ void TalkingHeadsPluginAudioProcessor::prepareToPlay(double sampleRate, int samp
 	multiSpec.numChannels = totalNumOutputChannels;
 
 	// -- Bypass
-	bypass = stateManager->getFloatValue(bypassID);
+	bypass = bypassParam.getInBound();
 
 	// -- Blend
 	initBlendMixer(sampleRate, samplesPerBlock);
 
 	// -- pre gain
-	preGainGain = stateManager->getFloatValue(preGainID);
+	preGainGain = preGainParam.getInBound();
 	preGain.setRampDurationSeconds(0.01f);
 	preGain.setGainDecibels(preGainGain);
 	preGain.prepare(monoSpec);
 
+	// -- Stage kernels, before the EQ designs its filters -- the compressor and imager only have Reference
+	multiBandEQ.setImplementation(dspImplementation);
+
 	// -- multi EQ
 	multiBandEQ.setSampleRate(monoSpec.sampleRate);
 	multiBandEQ.prepare(monoSpec);
@@ -203,17 +246,23 @@ void TalkingHeadsPluginAudioProcessor::prepareToPlay(double sampleRate, int samp
 	initPhaser(multiSpec);
 
 	// -- Setup smoothing
-	stateManager->initSmoothedValues(sampleRate);
+	stateManager->initSmoothedValues(sampleRate, samplesPerBlock);
+
+	// -- Session recording for offline replay
+	if (juce::SystemStats::getEnvironmentVariable(AUTOMATION_TRACE_ENV, {}).isNotEmpty() && !automationRecorder.isRecording())
+	{
+		startAutomationRecording(getAutomationTraceCapacity(sampleRate, samplesPerBlock));
+	}
 }
 
 void TalkingHeadsPluginAudioProcessor::initPhaser(const juce::dsp::ProcessSpec& spec)
 {
-	phaserBypass = stateManager->getBoolValue(phaserBypassID);
-	phaserRate = stateManager->getFloatValue(phaserRateID);
-	phaserDepth = stateManager->getFloatValue(phaserDepthID);
-	phaserCentreFrequency = stateManager->getFloatValue(phaserCentreFrequencyID);
-	phaserFeedback = stateManager->getFloatValue(phaserFeedbackID);
-	phaserMix = stateManager->getFloatValue(phaserMixID);
+	phaserBypass = phaserBypassParam.getBool();
+	phaserRate = phaserRateParam.getInBound();
+	phaserDepth = phaserDepthParam.getInBound();
+	phaserCentreFrequency = phaserCentreFrequencyParam.getInBound();
+	phaserFeedback = phaserFeedbackParam.getInBound();
+	phaserMix = phaserMixParam.getInBound();
 
 	phaser.setRate(phaserRate);
 	phaser.setDepth(phaserDepth);
@@ -228,6 +277,7 @@ void TalkingHeadsPluginAudioProcessor::releaseResources()
 {
 	// When playback stops, you can use this as an opportunity to free up any
 	// spare memory, etc.
+	writeAutomationTrace();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -259,7 +309,15 @@ void TalkingHeadsPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
 		buffer.clear(i, 0, numSamples);
 	}
 
-	preProcessBlock();
+	STAGE_PROFILER_BLOCK(stageProfiler, numSamples);
+
+	telemetry.beginBlock(numSamples);
+	telemetry.setStageLevels(TelemetryStage::input, juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(totalNumInputChannels)));
+
+	{
+		STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::preProcessBlock);
+		preProcessBlock(numSamples);
+	}
 
 	if (!juce::approximatelyEqual(bypass, 1.f))
 	{
@@ -271,30 +329,63 @@ void TalkingHeadsPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& bu
 		auto& outputBlock = context.getOutputBlock();
 
 		// -- prepare dry wet mixer -- dryWetMixer needs an AudioBlock with same number of input and output channels
-		blendMixer.setWetLatency(getLatency());
-		blendMixer.pushDrySamples(createDryBlock(buffer, totalNumOutputChannels, numSamples));
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::blendMixer);
+			blendMixer.setWetLatency(getLatency());
+			blendMixer.pushDrySamples(createDryBlock(buffer, totalNumOutputChannels, numSamples));
+		}
 
 		// -- Process mono stages
 		auto monoBlock = audioBlock.getSingleChannelBlock(0); // -- get the mono block
 		juce::dsp::ProcessContextReplacing<float> monoContext(monoBlock);
 
-		preGain.process(monoContext);
-		multiBandEQ.process(monoContext);
-		multiBandCompressor.process(monoContext);
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::preGain);
+			preGain.process(monoContext);
+		}
+		telemetry.setStageLevels(TelemetryStage::preGain, monoBlock);
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::multiBandEQ);
+			multiBandEQ.process(monoContext);
+		}
+		telemetry.setStageLevels(TelemetryStage::multiBandEQ, monoBlock);
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::multiBandCompressor);
+			multiBandCompressor.setGainReductionMetering(telemetry.isPublishing());
+			multiBandCompressor.process(monoContext);
+		}
+		telemetry.setStageLevels(TelemetryStage::multiBandCompressor, monoBlock);
+		for (int band{ 0 }; band < TelemetryChannel::numCompressorBands; ++band)
+		{
+			telemetry.setGainReduction(band, multiBandCompressor.getGainReductionDecibels(band));
+		}
 
 		// -- Mono to stereo -- context right now has audio only in the mono channel, the imager will transform it to stereo and add width
-		imager.process(context);
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::imager);
+			imager.process(context);
+		}
+		telemetry.setStageLevels(TelemetryStage::imager, audioBlock);
+		telemetry.setImagerWidth(imager.getWidth());
 
 		// -- Process multi channel stages
 		if (!isPhaserBypassed)
 		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::phaser);
 			phaser.process(context);
+			telemetry.setStageLevels(TelemetryStage::phaser, audioBlock);
 		}
 
 		// -- mix dry wet
-		blendMixer.mixWetSamples(outputBlock);
+		{
+			STAGE_PROFILER_SCOPE(stageProfiler, ProfiledStage::blendMixer);
+			blendMixer.mixWetSamples(outputBlock);
+		}
 	}
 
+	telemetry.setStageLevels(TelemetryStage::output, juce::dsp::AudioBlock<float>(buffer));
+	telemetry.endBlock();
+
 	postProcessBlock();
 }
 
@@ -313,18 +404,24 @@ juce::AudioProcessorEditor* TalkingHeadsPluginAudioProcessor::createEditor()
 //==============================================================================
 void TalkingHeadsPluginAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-	auto state = stateManager->getAPVTS()->copyState();
-	std::unique_ptr<juce::XmlElement> xml(state.createXml());
-	copyXmlToBinary(*xml, destData);
+	PluginStateFormat::write(*stateManager, destData);
 }
 
 void TalkingHeadsPluginAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+	if (PluginStateFormat::read(*stateManager, data, sizeInBytes))
+	{
+		return;
+	}
+
+	// -- states saved before the binary format
 	std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
 	if (xmlState.get() != nullptr && xmlState->hasTagName(stateManager->getAPVTS()->state.getType()))
 	{
-		stateManager->getAPVTS()->replaceState(juce::ValueTree::fromXml(*xmlState));
+		auto state = juce::ValueTree::fromXml(*xmlState);
+		stateManager->publishParameterSnapshot(PluginStateFormat::getPlainValues(state));
+		stateManager->getAPVTS()->replaceState(state);
 	}
 }
 
@@ -340,9 +437,149 @@ void TalkingHeadsPluginAudioProcessor::reset()
 }
 
 //==============================================================================
-void TalkingHeadsPluginAudioProcessor::preProcessBlock()
+void TalkingHeadsPluginAudioProcessor::setDSPImplementation(DSPImplementation newImplementation)
+{
+	dspImplementation = newImplementation;
+}
+
+DSPImplementation TalkingHeadsPluginAudioProcessor::getDSPImplementation() const
+{
+	return dspImplementation;
+}
+
+#if TALKINGHEADS_STAGE_PROFILING
+//==============================================================================
+StageProfiler& TalkingHeadsPluginAudioProcessor::getStageProfiler()
+{
+	return stageProfiler;
+}
+#endif
+
+//==============================================================================
+TelemetryChannel& TalkingHeadsPluginAudioProcessor::getTelemetry()
+{
+	return telemetry;
+}
+
+//==============================================================================
+MemoryFootprint TalkingHeadsPluginAudioProcessor::getMemoryFootprint()
+{
+	const size_t maximumBlockSize = static_cast<size_t>(juce::jmax(0, getBlockSize()));
+	const size_t numOutputChannels = static_cast<size_t>(getTotalNumOutputChannels());
+
+	MemoryFootprint footprint;
+	footprint.add("processor", sizeof(TalkingHeadsPluginAudioProcessor));
+	footprint.add("stateManager", stateManager->getMemoryFootprint());
+	footprint.add("blendMixerBuffer", MemoryFootprint::getBufferBytes(blendMixerBuffer));
+	// -- juce internals, sized from the spec they were prepared with
+	footprint.add("blendMixer", numOutputChannels * maximumBlockSize * sizeof(float));
+	footprint.add("multiBandEQ", multiBandEQ.getMemoryFootprint());
+	footprint.add("multiBandCompressor", multiBandCompressor.getMemoryFootprint());
+	footprint.add("imager", imager.getMemoryFootprint());
+	footprint.add("phaser", (numOutputChannels + 1) * maximumBlockSize * sizeof(float));
+	return footprint;
+}
+
+//==============================================================================
+void TalkingHeadsPluginAudioProcessor::startAutomationRecording(size_t capacityInBytes)
+{
+	automationRecorder.start(getSampleRate(), capacityInBytes);
+}
+
+juce::MemoryBlock TalkingHeadsPluginAudioProcessor::stopAutomationRecording()
+{
+	return automationRecorder.stop();
+}
+
+bool TalkingHeadsPluginAudioProcessor::startAutomationReplay(const juce::MemoryBlock& trace)
+{
+	isReplayingAutomation = false;
+	if (!automationPlayer.load(trace))
+	{
+		return false;
+	}
+	// -- its blocks are processed as they were recorded, none may be longer than prepareToPlay allowed for
+	if (automationPlayer.getMaxBlockSize() > getBlockSize())
+	{
+		return false;
+	}
+
+	// -- The recorded session was settled when it started: start from the first keyframe rather than
+	// -- ramping from the defaults, its values then match and the first replayed block sets no ramps
+	int firstNumSamples = 0;
+	if (automationPlayer.readBlock(firstNumSamples, replayValues))
+	{
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			stateManager->setCurrentAndTargetValue(intToEnum(i, ControlID), replayValues[i]);
+		}
+	}
+	automationPlayer.rewind();
+
+	isReplayingAutomation = true;
+	return true;
+}
+
+void TalkingHeadsPluginAudioProcessor::stopAutomationReplay()
+{
+	isReplayingAutomation = false;
+}
+
+size_t TalkingHeadsPluginAudioProcessor::getAutomationTraceCapacity(double sampleRate, int samplesPerBlock) const
+{
+	// -- sized for the worst case, every parameter changing every block, over the expected session length
+	const double seconds = juce::SystemStats::getEnvironmentVariable(AUTOMATION_TRACE_SECONDS_ENV, {}).getDoubleValue();
+	const double blocksPerSecond = sampleRate / static_cast<double>(juce::jmax(1, samplesPerBlock));
+	const double numBlocks = std::ceil((seconds > 0.0 ? seconds : defaultAutomationTraceSeconds) * blocksPerSecond);
+	return static_cast<size_t>(AutomationTrace::headerSize) + static_cast<size_t>(numBlocks) * static_cast<size_t>(AutomationTrace::maxBlockRecordSize);
+}
+
+void TalkingHeadsPluginAudioProcessor::writeAutomationTrace()
+{
+	// -- an overflow stops the recording but keeps what fitted
+	if (!automationRecorder.isRecording() && !automationRecorder.hasOverflowed())
+	{
+		return;
+	}
+
+	const bool overflowed = automationRecorder.hasOverflowed();
+	auto trace = stopAutomationRecording();
+
+	// -- Reported through juce::Logger, release builds included: hosts and tools can install a logger to collect it
+	auto directory = juce::File(juce::SystemStats::getEnvironmentVariable(AUTOMATION_TRACE_ENV, {}));
+	if (directory.getFullPathName().isEmpty() || !directory.createDirectory())
+	{
+		juce::Logger::writeToLog("Automation trace not written: cannot create " + directory.getFullPathName());
+		return;
+	}
+
+	auto file = directory.getNonexistentChildFile(
+		juce::String(JucePlugin_Name) + "_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S"),
+		".thtrace"
+	);
+	if (!file.replaceWithData(trace.getData(), trace.getSize()))
+	{
+		juce::Logger::writeToLog("Automation trace not written: cannot write " + file.getFullPathName());
+		return;
+	}
+	juce::Logger::writeToLog("Automation trace written to " + file.getFullPathName() + (overflowed ? " (capacity reached, truncated)" : ""));
+}
+
+//==============================================================================
+void TalkingHeadsPluginAudioProcessor::preProcessBlock(int numSamples)
 {
-	stateManager->syncInBoundVariables();
+	int traceNumSamples = 0;
+	if (isReplayingAutomation.load(std::memory_order_relaxed) && automationPlayer.readBlock(traceNumSamples, replayValues))
+	{
+		// -- the caller drives the block sizes from the trace, numSamples only differs if it does not
+		jassert(traceNumSamples == numSamples);
+		stateManager->syncInBoundVariables(numSamples, replayValues);
+	}
+	else
+	{
+		stateManager->syncInBoundVariables(numSamples);
+		automationRecorder.recordBlock(numSamples, *stateManager);
+	}
 	postUpdatePluginParameters();
 }
 
@@ -352,8 +589,8 @@ void TalkingHeadsPluginAudioProcessor::postProcessBlock()
 
 void TalkingHeadsPluginAudioProcessor::postUpdatePluginParameters()
 {
-	float newBypass = stateManager->getCurrentValue(bypassID);
-	float newBlend = stateManager->getCurrentValue(blendID);
+	float newBypass = bypassParam.get();
+	float newBlend = blendParam.get();
 
 	if (!juce::approximatelyEqual(newBypass, bypass) || !juce::approximatelyEqual(newBlend, blend))
 	{
@@ -362,10 +599,10 @@ void TalkingHeadsPluginAudioProcessor::postUpdatePluginParameters()
 		blendMixer.setWetMixProportion(std::max(0.f, blend * (1.f - bypass))); // -- if bypassing, all dry. bypass should smooth from 0.f to 1.f when selected.
 	}
 
-	float newPreGainGain = stateManager->getCurrentValue(preGainID);
+	float newPreGainGain = preGainParam.get();
 	if (!juce::approximatelyEqual(newPreGainGain, preGainGain))
 	{
-		preGain.setGainDecibels(stateManager->getCurrentValue(preGainID));
+		preGain.setGainDecibels(preGainParam.get());
 	}
 
 	float newSampleRate = getSampleRate();
@@ -380,7 +617,7 @@ void TalkingHeadsPluginAudioProcessor::postUpdatePluginParameters()
 
 void  TalkingHeadsPluginAudioProcessor::postUpdatePhaserParameters()
 {
-	float newPhaserBypass = stateManager->getCurrentValue(phaserBypassID);
+	float newPhaserBypass = phaserBypassParam.get();
 	bool phaserBypassChanged = !juce::approximatelyEqual(newPhaserBypass, phaserBypass);
 	if (phaserBypassChanged)
 	{
@@ -393,35 +630,35 @@ void  TalkingHeadsPluginAudioProcessor::postUpdatePhaserParameters()
 		return;
 	}
 
-	float newPhaserRate = stateManager->getCurrentValue(phaserRateID);
+	float newPhaserRate = phaserRateParam.get();
 	if (!juce::approximatelyEqual(newPhaserRate, phaserRate))
 	{
 		phaserRate = newPhaserRate;
 		phaser.setRate(phaserRate);
 	}
 
-	float newPhaserDepth = stateManager->getCurrentValue(phaserDepthID);
+	float newPhaserDepth = phaserDepthParam.get();
 	if (!juce::approximatelyEqual(newPhaserDepth, phaserDepth))
 	{
 		phaserDepth = newPhaserDepth;
 		phaser.setDepth(phaserDepth);
 	}
 
-	float newPhaserCentreFrequency = stateManager->getCurrentValue(phaserCentreFrequencyID);
+	float newPhaserCentreFrequency = phaserCentreFrequencyParam.get();
 	if (!juce::approximatelyEqual(newPhaserCentreFrequency, phaserCentreFrequency))
 	{
 		phaserCentreFrequency = newPhaserCentreFrequency;
 		phaser.setCentreFrequency(phaserCentreFrequency);
 	}
 
-	float newPhaserFeedback = stateManager->getCurrentValue(phaserFeedbackID);
+	float newPhaserFeedback = phaserFeedbackParam.get();
 	if (!juce::approximatelyEqual(newPhaserFeedback, phaserFeedback))
 	{
 		phaserFeedback = newPhaserFeedback;
 		phaser.setFeedback(phaserFeedback);
 	}
 
-	float newPhaserMix = stateManager->getCurrentValue(phaserMixID);
+	float newPhaserMix = phaserMixParam.get();
 	if (!juce::approximatelyEqual(newPhaserMix, phaserMix) || phaserBypassChanged)
 	{
 		phaserMix = newPhaserMix;
@@ -457,7 +694,7 @@ void  TalkingHeadsPluginAudioProcessor::initBlendMixer(double sampleRate, int sa
 	mixerSpec.maximumBlockSize = samplesPerBlock;
 	mixerSpec.numChannels = totalNumOutputChannels;
 
-	blend = stateManager->getFloatValue(blendID);
+	blend = blendParam.getInBound();
 
 	blendMixer.setMixingRule(juce::dsp::DryWetMixingRule::linear);
 	blendMixer.setWetMixProportion(blend);
@@ -12,9 +12,16 @@
 #include <cmath>
 #include "parameterTypes.h"
 #include "PluginStateManager.h"
+#include "ParameterHandle.h"
+#include "PluginStateFormat.h"
+#include "PresetBank.h"
+#include "DSPImplementation.h"
 #include "MultiBandEQ.h"
 #include "MultiBandCompressor.h"
 #include "Imager.h"
+#include "StageProfiler.h"
+#include "TelemetryChannel.h"
+#include "AutomationTrace.h"
 
 //==============================================================================
 /**
@@ -59,6 +66,13 @@ public:
 	const juce::String getProgramName(int index) override;
 	void changeProgramName(int index, const juce::String& newName) override;
 
+	// -- Presets -- message thread, switching programs morphs the smoothed parameters over the morph time.
+	// -- The program list only changes through the processor, so the current program stays valid and the host hears of it
+	const PresetBank& getPresetBank() const;
+	int storeProgram(const juce::String& name); // -- adds the current parameter values as a new program
+	void removeProgram(int index); // -- the last program is never removed
+	void setProgramMorphTime(double newMorphTimeInSeconds);
+
 	//==============================================================================
 	void getStateInformation(juce::MemoryBlock& destData) override;
 	void setStateInformation(const void* data, int sizeInBytes) override;
@@ -66,6 +80,32 @@ public:
 	//==============================================================================
 	void reset() override;
 
+#if TALKINGHEADS_STAGE_PROFILING
+	//==============================================================================
+	// -- Per-stage timing, drained from a non audio thread
+	StageProfiler& getStageProfiler();
+#endif
+
+	//==============================================================================
+	// -- Which kernels the stages run, applied by the next prepareToPlay (defaultDSPImplementation until set)
+	void setDSPImplementation(DSPImplementation newImplementation);
+	DSPImplementation getDSPImplementation() const;
+
+	//==============================================================================
+	// -- Meters and parameter echoes for the UI, drained from the message thread
+	TelemetryChannel& getTelemetry();
+
+	//==============================================================================
+	// -- Bytes per component of this instance, call after prepareToPlay
+	MemoryFootprint getMemoryFootprint();
+
+	//==============================================================================
+	// -- Automation traces -- recording can run alongside playback, replay must be started after prepareToPlay while not processing
+	void startAutomationRecording(size_t capacityInBytes = 32 * 1024 * 1024);
+	juce::MemoryBlock stopAutomationRecording();
+	bool startAutomationReplay(const juce::MemoryBlock& trace); // -- false for a malformed trace or one with blocks longer than prepared
+	void stopAutomationReplay();
+
 private:
 	//==============================================================================
 	// --- Object parameters management and information
@@ -73,17 +113,17 @@ private:
 	std::shared_ptr<PluginStateManager> stateManager;
 
 	// -- General parameters
-	ControlID bypassID{ ControlID::bypass };
-	ControlID blendID{ ControlID::blend };
-	ControlID preGainID{ ControlID::preGain };
+	Param<ControlID::bypass> bypassParam;
+	Param<ControlID::blend> blendParam;
+	Param<ControlID::preGain> preGainParam;
 
 	// -- Phaser
-	ControlID phaserBypassID{ ControlID::phaserBypass };
-	ControlID phaserRateID{ ControlID::phaserRate };
-	ControlID phaserDepthID{ ControlID::phaserDepth };
-	ControlID phaserCentreFrequencyID{ ControlID::phaserCentreFrequency };
-	ControlID phaserFeedbackID{ ControlID::phaserFeedback };
-	ControlID phaserMixID{ ControlID::phaserMix };
+	Param<ControlID::phaserBypass> phaserBypassParam;
+	Param<ControlID::phaserRate> phaserRateParam;
+	Param<ControlID::phaserDepth> phaserDepthParam;
+	Param<ControlID::phaserCentreFrequency> phaserCentreFrequencyParam;
+	Param<ControlID::phaserFeedback> phaserFeedbackParam;
+	Param<ControlID::phaserMix> phaserMixParam;
 
 	//==============================================================================
 	// --- Object member variables
@@ -104,6 +144,8 @@ private:
 	float preGainGain{ 0.f };
 	juce::dsp::Gain<float> preGain;
 
+	DSPImplementation dspImplementation{ defaultDSPImplementation };
+
 	// -- Multi Band EQ
 	float multiBandEQSampleRate{ 0.f };
 	MultiBandEQ multiBandEQ;
@@ -111,10 +153,6 @@ private:
 	// -- Multi Band Compressor
 	MultiBandCompressor multiBandCompressor;
 
-	// -- Stereo Imager
-	juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> stereoImagerDelayLine{ 192000 };
-	juce::AudioBuffer<float> stereoImagerBuffer;
-
 	// -- Multi channel stages
 
 	// -- Imager
@@ -130,16 +168,39 @@ private:
 	float phaserMix{ 0.f };
 	juce::dsp::Phaser<float> phaser;
 
+#if TALKINGHEADS_STAGE_PROFILING
+	StageProfiler stageProfiler;
+#endif
+
+	TelemetryChannel telemetry;
+
+	// -- Presets
+	PresetBank presetBank;
+	int currentProgram{ 0 };
+	double programMorphTimeInSeconds{ 0.05 };
+
+	// -- Automation traces
+	const juce::String AUTOMATION_TRACE_ENV = "TALKINGHEADS_AUTOMATION_TRACE"; // -- directory to record every session to
+	const juce::String AUTOMATION_TRACE_SECONDS_ENV = "TALKINGHEADS_AUTOMATION_TRACE_SECONDS"; // -- session length the recording is sized for
+	static constexpr double defaultAutomationTraceSeconds{ 60.0 };
+	AutomationTraceRecorder automationRecorder;
+	AutomationTracePlayer automationPlayer;
+	AutomationTrace::Values replayValues{};
+	std::atomic<bool> isReplayingAutomation{ false };
+
 	//==============================================================================
 	void initBlendMixer(double sampleRate, int samplesPerBlock);
 	void initPhaser(const juce::dsp::ProcessSpec& spec);
 
 	//==============================================================================
-	void preProcessBlock();
+	void preProcessBlock(int numSamples);
 	void postProcessBlock();
 
 	void postUpdatePluginParameters();
 	void postUpdatePhaserParameters();
+
+	size_t getAutomationTraceCapacity(double sampleRate, int samplesPerBlock) const;
+	void writeAutomationTrace();
 	//==============================================================================
 	float getLatency();
 
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+	PluginStateFormat.cpp
+
+  ==============================================================================
+*/
+
+#include <array>
+#include <cmath>
+#include "PluginStateFormat.h"
+
+namespace
+{
+	//==============================================================================
+	// -- Little endian helpers
+	inline void writeUInt16(char* destination, juce::uint16 value)
+	{
+		value = juce::ByteOrder::swapIfBigEndian(value);
+		std::memcpy(destination, &value, sizeof(value));
+	}
+
+	inline void writeUInt32(char* destination, juce::uint32 value)
+	{
+		value = juce::ByteOrder::swapIfBigEndian(value);
+		std::memcpy(destination, &value, sizeof(value));
+	}
+
+	inline void writeFloat(char* destination, float value)
+	{
+		juce::uint32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		writeUInt32(destination, bits);
+	}
+
+	inline juce::uint32 readUInt32(const char* source)
+	{
+		return juce::ByteOrder::littleEndianInt(source);
+	}
+
+	inline float readFloat(const char* source)
+	{
+		juce::uint32 bits = readUInt32(source);
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//==============================================================================
+	// -- ControlID -> parameter ID hash
+	constexpr std::array<juce::uint32, ControlID::countParams> makeParameterIDHashes()
+	{
+		std::array<juce::uint32, ControlID::countParams> hashes{};
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			hashes[i] = PluginStateFormat::hashParameterID(ParameterDescriptors::table[i].id);
+		}
+		return hashes;
+	}
+
+	constexpr std::array<juce::uint32, ControlID::countParams> parameterIDHashes = makeParameterIDHashes();
+
+	// -- States are written in ControlID order, try the expected slot before searching
+	int findControlID(juce::uint32 hash, int expectedIndex)
+	{
+		if (expectedIndex < ControlID::countParams && parameterIDHashes[expectedIndex] == hash)
+		{
+			return expectedIndex;
+		}
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			if (parameterIDHashes[i] == hash)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+}
+
+//==============================================================================
+void PluginStateFormat::write(PluginStateManager& stateManager, juce::MemoryBlock& destData)
+{
+	destData.setSize(static_cast<size_t>(stateSize), false);
+	char* writer = static_cast<char*>(destData.getData());
+
+	// -- Header
+	writeUInt32(writer, magic);
+	writeUInt16(writer + 4, formatVersion);
+	writeUInt16(writer + 6, parameterVersion);
+	writeUInt16(writer + 8, static_cast<juce::uint16>(ControlID::countParams));
+	writeUInt16(writer + 10, 0);
+	writer += headerSize;
+
+	// -- Entries
+	const auto values = stateManager.getParameterValues();
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		writeUInt32(writer, parameterIDHashes[i]);
+		writeFloat(writer + 4, values[i]);
+		writer += entrySize;
+	}
+}
+
+bool PluginStateFormat::read(PluginStateManager& stateManager, const void* data, int sizeInBytes)
+{
+	if (data == nullptr || sizeInBytes < headerSize)
+	{
+		return false;
+	}
+
+	const char* reader = static_cast<const char*>(data);
+	if (readUInt32(reader) != magic || juce::ByteOrder::littleEndianShort(reader + 4) != formatVersion)
+	{
+		return false;
+	}
+
+	// -- a newer parameter version may have changed what existing parameters mean, do not guess
+	const int stateParameterVersion = juce::ByteOrder::littleEndianShort(reader + 6);
+	if (stateParameterVersion < VersionIDs::V1_0_0 || stateParameterVersion > parameterVersion)
+	{
+		return false;
+	}
+
+	const int numEntries = juce::ByteOrder::littleEndianShort(reader + 8);
+	if (sizeInBytes < headerSize + numEntries * entrySize)
+	{
+		return false;
+	}
+	reader += headerSize;
+
+	// -- parameters the state does not hold go back to their default
+	std::array<float, ControlID::countParams> values{};
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		values[i] = ParameterDescriptors::table[i].defaultValue;
+	}
+
+	for (int entry{ 0 }; entry < numEntries; ++entry)
+	{
+		const int index = findControlID(readUInt32(reader), entry);
+		const float value = readFloat(reader + 4);
+		if (index >= 0 && std::isfinite(value))
+		{
+			values[index] = value;
+		}
+		reader += entrySize;
+	}
+
+	stateManager.restoreParameterValues(values);
+	return true;
+}
+
+std::array<float, ControlID::countParams> PluginStateFormat::getPlainValues(const juce::ValueTree& state)
+{
+	// -- APVTS keeps one PARAM child per parameter, with its id and plain value
+	static const juce::Identifier idPropertyID{ "id" };
+	static const juce::Identifier valuePropertyID{ "value" };
+
+	std::array<float, ControlID::countParams> values{};
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		const auto& descriptor = ParameterDescriptors::table[i];
+		auto child = state.getChildWithProperty(idPropertyID, juce::String(descriptor.id));
+		values[i] = child.isValid() ? static_cast<float>(child.getProperty(valuePropertyID, descriptor.defaultValue)) : descriptor.defaultValue;
+	}
+	return values;
+}
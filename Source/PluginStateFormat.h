@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+	PluginStateFormat.h
+	Binary plugin state for get/setStateInformation, no XML or string building
+
+	Binary format (little endian):
+	-- header: 'THST' magic (uint32), format version (uint16), parameter VersionIDs (uint16),
+	   number of entries (uint16), reserved (uint16)
+	-- per entry: parameter ID hash (uint32, FNV-1a of the APVTS parameter ID), plain value (float32)
+
+	Entries are keyed by parameter ID, not ControlID, so reordering or removing ControlIDs keeps
+	old states readable: unknown hashes are skipped, parameters missing from the state (added in a
+	later VersionIDs) go back to their default. States from a newer VersionIDs than this build's
+	parameterVersion are rejected rather than loaded with their unknown parameters dropped.
+	States saved as XML are not recognised, the processor falls back to its XML reader for them.
+
+	Both readers publish the restored values to PluginStateManager as one snapshot before the
+	parameters change, so the audio thread switches to the whole state in a single block.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "parameterTypes.h"
+#include "ParameterDescriptors.h"
+#include "PluginStateManager.h"
+
+namespace PluginStateFormat
+{
+	//==============================================================================
+	static constexpr juce::uint32 magic{ 0x54534854 }; // -- "THST"
+	static constexpr juce::uint16 formatVersion{ 1 };
+	static constexpr juce::uint16 parameterVersion{ VersionIDs::V1_0_0 }; // -- newest VersionIDs this build knows, bump with the parameter table
+	static constexpr int headerSize{ 12 };
+	static constexpr int entrySize{ 8 };
+	static constexpr int stateSize{ headerSize + entrySize * ControlID::countParams };
+
+	//==============================================================================
+	// -- FNV-1a, 32 bits
+	constexpr juce::uint32 hashParameterID(const char* parameterID)
+	{
+		juce::uint32 hash{ 2166136261u };
+		for (; *parameterID != '\0'; ++parameterID)
+		{
+			hash = (hash ^ static_cast<juce::uint8>(*parameterID)) * 16777619u;
+		}
+		return hash;
+	}
+
+	constexpr bool hasUniqueParameterIDHashes()
+	{
+		for (int i{ 0 }; i < ControlID::countParams; ++i)
+		{
+			for (int j{ i + 1 }; j < ControlID::countParams; ++j)
+			{
+				if (hashParameterID(ParameterDescriptors::table[i].id) == hashParameterID(ParameterDescriptors::table[j].id))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	static_assert(hasUniqueParameterIDHashes(), "Two parameter IDs share a hash, the binary state cannot tell them apart");
+
+	//==============================================================================
+	// -- Writes every parameter's plain value
+	void write(PluginStateManager& stateManager, juce::MemoryBlock& destData);
+	// -- False when data is not a binary state (XML states, other formats) or one saved by a newer parameter version, nothing is changed then
+	bool read(PluginStateManager& stateManager, const void* data, int sizeInBytes);
+	// -- Plain values of an APVTS state (the XML format), defaults for the parameters it does not hold
+	std::array<float, ControlID::countParams> getPlainValues(const juce::ValueTree& state);
+}
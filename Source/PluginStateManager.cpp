@@ -18,96 +18,63 @@ PluginStateManager::PluginStateManager(
 	juce::UndoManager* undoManagerToUse,
 	const juce::Identifier& valueTreeType
 ) :
-	apvts_ptr(
-		new juce::AudioProcessorValueTreeState(
+	apvts(
+		std::make_unique<juce::AudioProcessorValueTreeState>(
 			processorToConnectTo,
 			undoManagerToUse,
 			valueTreeType,
-			initParamsAndCreateLayout()
+			createParameterLayout()
 		)
 	)
 {
-	attachParameters(*apvts_ptr);
-	syncInBoundVariables();
-}
+	// -- attaching reads every inbound value, no sync needed before prepare
+	attachParameters(*apvts);
 
-PluginStateManager::~PluginStateManager()
-{
-	for (auto& param : parameters)
+	for (int i{ 0 }; i < ParameterDescriptors::numLinearSmoothed; i++)
 	{
-		param = nullptr;
+		linearSmoothers.setRampLength(i, ParameterDescriptors::get(ParameterDescriptors::linearSmoothedControlIDs[i]).rampLengthInSeconds);
+	}
+	for (int i{ 0 }; i < ParameterDescriptors::numMultiplicativeSmoothed; i++)
+	{
+		multiplicativeSmoothers.setRampLength(i, ParameterDescriptors::get(ParameterDescriptors::multiplicativeSmoothedControlIDs[i]).rampLengthInSeconds);
+	}
+	// -- smoothers and the current value cache start at the attached values
+	for (int i{ 0 }; i < ControlID::countParams; i++)
+	{
+		setCurrentAndTargetValue(intToEnum(i, ControlID), parameters[i].getFloatValue());
 	}
-	delete apvts_ptr;
-}
-
-//==============================================================================
-// TODO: implement copy/move constructors and copy/move assignment operators
-PluginStateManager::PluginStateManager(const PluginStateManager& other) : // copy constructor
-	apvts_ptr(other.apvts_ptr),
-	parameterIDs(other.parameterIDs),
-	parameterTypes(other.parameterTypes),
-	parameters(other.parameters),
-	smoothingTypes(other.smoothingTypes),
-	smoothingValueIndexes(other.smoothingValueIndexes),
-	linearSmoothedValues(other.linearSmoothedValues),
-	multiplicativeSmoothedValues(other.multiplicativeSmoothedValues)
-{
-}
 
-// TODO: check how to implement move constructor correctly for array variables
-PluginStateManager::PluginStateManager(PluginStateManager&& other) noexcept : // move constructor
-	apvts_ptr(std::exchange(other.apvts_ptr, nullptr)),
-	parameterIDs(other.parameterIDs),
-	parameterTypes(other.parameterTypes),
-	parameters(other.parameters),
-	smoothingTypes(other.smoothingTypes),
-	smoothingValueIndexes(other.smoothingValueIndexes),
-	linearSmoothedValues(other.linearSmoothedValues),
-	multiplicativeSmoothedValues(other.multiplicativeSmoothedValues)
-{
-}
+	for (int i{ 0 }; i < ParameterGroupID::countGroups; i++)
+	{
+		const auto& group = ParameterDescriptors::groups[i];
+		groupMasks[i] = DirtyBitset<ControlID::countParams>::makeRange(group.firstID, group.endID);
+	}
 
-PluginStateManager& PluginStateManager::operator=(const PluginStateManager& other) // copy assignment
-{
-	if (this == &other)
+	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		return *this;
+		parameterChangeListeners[i].dirtyParameters = &dirtyParameters;
+		parameterChangeListeners[i].controlID = i;
+		apvts->addParameterListener(ParameterDescriptors::table[i].id, &parameterChangeListeners[i]);
 	}
-	apvts_ptr = other.apvts_ptr;
-	parameterIDs = other.parameterIDs;
-	parameterTypes = other.parameterTypes;
-	parameters = other.parameters;
-	smoothingTypes = other.smoothingTypes;
-	smoothingValueIndexes = other.smoothingValueIndexes;
-	linearSmoothedValues = other.linearSmoothedValues;
-	multiplicativeSmoothedValues = other.multiplicativeSmoothedValues;
-
-	return *this;
 }
 
-PluginStateManager& PluginStateManager::operator=(PluginStateManager&& other) noexcept // move assignment
+PluginStateManager::~PluginStateManager()
 {
-	if (this == &other)
+	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		return *this;
+		apvts->removeParameterListener(ParameterDescriptors::table[i].id, &parameterChangeListeners[i]);
 	}
-	std::swap(apvts_ptr, other.apvts_ptr);
-	std::swap(parameterIDs, other.parameterIDs);
-	std::swap(parameterTypes, other.parameterTypes);
-	std::swap(parameters, other.parameters);
-	std::swap(smoothingTypes, other.smoothingTypes);
-	std::swap(smoothingValueIndexes, other.smoothingValueIndexes);
-	std::swap(linearSmoothedValues, other.linearSmoothedValues);
-	std::swap(multiplicativeSmoothedValues, other.multiplicativeSmoothedValues);
-
-	return *this;
+
+	delete pendingSnapshot.exchange(nullptr);
+	delete retiredSnapshot.exchange(nullptr);
+	delete adoptedSnapshot;
 }
 
 //==============================================================================
 // // --- APVTS
 juce::AudioProcessorValueTreeState* PluginStateManager::getAPVTS()
 {
-	return apvts_ptr;
+	return apvts.get();
 }
 
 // -- Parameters
@@ -115,390 +82,519 @@ void PluginStateManager::attachParameters(const juce::AudioProcessorValueTreeSta
 {
 	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		parameters[i] = std::make_shared<ParameterObject>(
-			ParameterObject(
-				apvts.getParameter(parameterIDs[i]),
-				parameterTypes[i]
-			)
+		parameters[i] = ParameterObject(
+			apvts.getParameter(ParameterDescriptors::table[i].id),
+			ParameterDescriptors::table[i].type,
+			apvts.getRawParameterValue(ParameterDescriptors::table[i].id)
 		);
 	}
 }
 
-std::shared_ptr<ParameterObject> PluginStateManager::getParameterObject(ControlID controlID)
+ParameterObject& PluginStateManager::getParameterObject(ControlID controlID)
 {
 	return parameters[controlID];
 }
 
 juce::RangedAudioParameter* PluginStateManager::getParameter(ControlID controlID)
 {
-	return parameters[controlID]->getParameter();
+	return parameters[controlID].getParameter();
 }
 
 // -- Inbound Values
 bool PluginStateManager::getBoolValue(ControlID controlID)
 {
-	return parameters[controlID]->getBoolValue();
+	return parameters[controlID].getBoolValue();
 }
 
 int PluginStateManager::getChoiceIndex(ControlID controlID)
 {
-	return parameters[controlID]->getChoiceIndex();
+	return parameters[controlID].getChoiceIndex();
 }
 
 template <typename ChoiceType>
 ChoiceType PluginStateManager::getChoiceValue(ControlID controlID)
 {
-	return parameters[controlID]->getChoiceValue<ChoiceType>();
+	return parameters[controlID].getChoiceValue<ChoiceType>();
 }
 
 float PluginStateManager::getFloatValue(ControlID controlID)
 {
-	return parameters[controlID]->getFloatValue();
+	return parameters[controlID].getFloatValue();
 }
 
 int PluginStateManager::getIntValue(ControlID controlID)
 {
-	return parameters[controlID]->getIntValue();
+	return parameters[controlID].getIntValue();
 }
 
 // -- Smoothing
-void PluginStateManager::initSmoothedValues(double sampleRate)
+int PluginStateManager::getSmoothedBlockCapacity() const
+{
+	return smoothedBlockSize;
+}
+
+void PluginStateManager::initSmoothedValues(double sampleRate, int maximumBlockSize)
 {
+	if (maximumBlockSize > smoothedBlockSize)
+	{
+		smoothedBlockSize = maximumBlockSize;
+		smoothedBlocks.allocate(static_cast<size_t>(ControlID::countParams) * static_cast<size_t>(smoothedBlockSize), true);
+	}
+
+	// -- pick up anything that changed while not processing (setStateInformation, UI...) or while its group was suspended
+	ParameterBits changedParameters = dirtyParameters.take();
+	for (size_t w{ 0 }; w < changedParameters.size(); w++)
+	{
+		changedParameters[w] |= pendingParameters[w];
+	}
+	pendingParameters = {};
+	suspendedGroups.fill(false);
+
+	// -- the audio thread is stopped and every value is read below, a snapshot left over would only bring older values back
+	delete pendingSnapshot.exchange(nullptr);
+	delete retiredSnapshot.exchange(nullptr);
+	delete adoptedSnapshot;
+	adoptedSnapshot = nullptr;
+
+	DirtyBitset<ControlID::countParams>::forEachSetBit(changedParameters, [this](int i)
+		{
+			parameters[i].updateInBoundVariable();
+		});
+
 	resetSmoothedValues(sampleRate);
 	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		setCurrentAndTargetValue(intToEnum(i, ControlID), parameters[i]->getFloatValue());
+		setCurrentAndTargetValue(intToEnum(i, ControlID), parameters[i].getFloatValue());
 	}
 }
 
 void PluginStateManager::resetSmoothedValues(double sampleRate)
 {
-	for (auto& smoothedValue : linearSmoothedValues)
-	{
-		smoothedValue.smoothedValue.reset(sampleRate, smoothedValue.rampLengthInSeconds);
-	}
-
-	for (auto& smoothedValue : multiplicativeSmoothedValues)
+	this->sampleRate = sampleRate;
+	linearSmoothers.reset(sampleRate);
+	multiplicativeSmoothers.reset(sampleRate);
+	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		smoothedValue.smoothedValue.reset(sampleRate, smoothedValue.rampLengthInSeconds);
+		updateCurrentValue(intToEnum(i, ControlID));
 	}
 }
 
 void PluginStateManager::reset(ControlID controlID, double sampleRate, double rampLengthInSeconds)
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
+	SmoothingType smoothingType = ParameterDescriptors::get(controlID).smoothingType;
 	if (smoothingType == SmoothingType::NoSmoothing)
 	{
 		return;
 	}
 
-	int idx = smoothingValueIndexes[controlID];
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
 	switch (smoothingType)
 	{
 	case SmoothingType::Linear:
-		linearSmoothedValues[idx].rampLengthInSeconds = rampLengthInSeconds;
-		linearSmoothedValues[idx].smoothedValue.reset(sampleRate, rampLengthInSeconds);
+		linearSmoothers.reset(idx, sampleRate, rampLengthInSeconds);
 		break;
 	case SmoothingType::Multiplicative:
-		multiplicativeSmoothedValues[idx].rampLengthInSeconds = rampLengthInSeconds;
-		multiplicativeSmoothedValues[idx].smoothedValue.reset(sampleRate, rampLengthInSeconds);
+		multiplicativeSmoothers.reset(idx, sampleRate, rampLengthInSeconds);
 		break;
 	}
+	updateCurrentValue(controlID);
 }
 
 
 float PluginStateManager::getCurrentValue(ControlID controlID)
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
-	if (smoothingType == SmoothingType::NoSmoothing)
-	{
-		return parameters[controlID]->getFloatValue();
-	}
+	// -- plain value, refreshed by the sync only for parameters that changed or ramped
+	return currentValues[controlID];
+}
 
-	int idx = smoothingValueIndexes[controlID];
-	float normalizedValue = 0.f;
-	switch (smoothingType)
+const float* PluginStateManager::getCurrentValueSlot(ControlID controlID)
+{
+	return &currentValues[controlID];
+}
+
+float PluginStateManager::getNextValue(ControlID controlID)
+{
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
+	switch (ParameterDescriptors::get(controlID).smoothingType)
 	{
 	case SmoothingType::Linear:
-		normalizedValue = linearSmoothedValues[idx].smoothedValue.getCurrentValue();
+		linearSmoothers.getNextValue(idx);
 		break;
 	case SmoothingType::Multiplicative:
-		normalizedValue = multiplicativeSmoothedValues[idx].smoothedValue.getCurrentValue();
+		multiplicativeSmoothers.getNextValue(idx);
+		break;
+	default:
+		break;
 	}
-	// Denormalize value to the selected range
-	return parameters[controlID]->getParameterRange().convertFrom0to1(safeDenormalizableValue(normalizedValue));
+	updateCurrentValue(controlID);
+	return currentValues[controlID];
 }
 
-float PluginStateManager::getNextValue(ControlID controlID)
+const float* PluginStateManager::getSmoothedBlock(ControlID controlID, int numSamples)
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
-	if (smoothingType == SmoothingType::NoSmoothing)
+	jassert(numSamples <= smoothedBlockSize);
+	if (smoothedBlocks == nullptr)
 	{
-		return parameters[controlID]->getFloatValue();
+		return getCurrentValueSlot(controlID);
 	}
 
-	int idx = smoothingValueIndexes[controlID];
-	float normalizedValue = 0.f;
-	switch (smoothingType)
+	// -- Never past this parameter's slot, whatever the host sends
+	numSamples = juce::jlimit(0, smoothedBlockSize, numSamples);
+	float* block = smoothedBlocks.getData() + static_cast<size_t>(controlID) * static_cast<size_t>(smoothedBlockSize);
+
+	const auto& descriptor = ParameterDescriptors::get(controlID);
+	if (descriptor.smoothingType == SmoothingType::NoSmoothing)
+	{
+		juce::FloatVectorOperations::fill(block, parameters[controlID].getFloatValue(), numSamples);
+		return block;
+	}
+
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
+	switch (descriptor.smoothingType)
 	{
 	case SmoothingType::Linear:
-		normalizedValue = linearSmoothedValues[idx].smoothedValue.getNextValue();
+		linearSmoothers.fillBlock(idx, block, numSamples);
 		break;
 	case SmoothingType::Multiplicative:
-		normalizedValue = multiplicativeSmoothedValues[idx].smoothedValue.getNextValue();
+		multiplicativeSmoothers.fillBlock(idx, block, numSamples);
+		break;
 	}
-	// Denormalize value to the selected range
-	return parameters[controlID]->getParameterRange().convertFrom0to1(safeDenormalizableValue(normalizedValue));
+
+	// Denormalize values to the selected range, same mapping as NormalisableRange::convertFrom0to1
+	const auto& range = descriptor.range;
+	juce::FloatVectorOperations::clip(block, block, 0.f, 1.f, numSamples);
+	if (range.skew != 1.f)
+	{
+		for (int i{ 0 }; i < numSamples; i++)
+		{
+			block[i] = block[i] > 0.f ? std::exp(std::log(block[i]) / range.skew) : 0.f;
+		}
+	}
+	juce::FloatVectorOperations::multiply(block, range.end - range.start, numSamples);
+	juce::FloatVectorOperations::add(block, range.start, numSamples);
+	return block;
 }
 
 void PluginStateManager::setCurrentAndTargetValue(ControlID controlID, float newValue)
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
-	if (smoothingType == SmoothingType::NoSmoothing)
+	const auto& descriptor = ParameterDescriptors::get(controlID);
+	if (descriptor.smoothingType == SmoothingType::NoSmoothing)
 	{
+		currentValues[controlID] = newValue;
 		return;
 	}
 
-	int idx = smoothingValueIndexes[controlID];
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
 	// Need to normalize the inBound variable to the range [0, 1] first
-	float normalizedNewValue = parameters[controlID]->getParameterRange().convertTo0to1(newValue);
-	switch (smoothingType)
+	float normalizedNewValue = ParameterDescriptors::convertTo0to1(descriptor.range, newValue);
+	switch (descriptor.smoothingType)
 	{
 	case SmoothingType::Linear:
-		linearSmoothedValues[idx].smoothedValue.setCurrentAndTargetValue(normalizedNewValue);
+		linearSmoothers.setCurrentAndTargetValue(idx, normalizedNewValue);
 		break;
 	case SmoothingType::Multiplicative:
-		multiplicativeSmoothedValues[idx].smoothedValue.setCurrentAndTargetValue(safeMultiplicativeValue(normalizedNewValue));
+		multiplicativeSmoothers.setCurrentAndTargetValue(idx, safeMultiplicativeValue(normalizedNewValue));
 		break;
 	}
+	updateCurrentValue(controlID);
 }
 
-void PluginStateManager::setTargetValue(ControlID controlID, float newValue)
+void PluginStateManager::setTargetValue(ControlID controlID, float newValue, int numSteps)
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
-	if (smoothingType == SmoothingType::NoSmoothing)
+	const auto& descriptor = ParameterDescriptors::get(controlID);
+	if (descriptor.smoothingType == SmoothingType::NoSmoothing)
 	{
+		currentValues[controlID] = newValue;
 		return;
 	}
 
-	int idx = smoothingValueIndexes[controlID];
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
 	// Need to normalize the inBound variable to the range [0, 1] first
-	float normalizedNewValue = parameters[controlID]->getParameterRange().convertTo0to1(newValue);
-	switch (smoothingType)
+	float normalizedNewValue = ParameterDescriptors::convertTo0to1(descriptor.range, newValue);
+	switch (descriptor.smoothingType)
 	{
 	case SmoothingType::Linear:
-		linearSmoothedValues[idx].smoothedValue.setTargetValue(normalizedNewValue);
+		linearSmoothers.setTargetValue(idx, normalizedNewValue, numSteps);
 		break;
 	case SmoothingType::Multiplicative:
-		multiplicativeSmoothedValues[idx].smoothedValue.setTargetValue(safeMultiplicativeValue(normalizedNewValue));
+		multiplicativeSmoothers.setTargetValue(idx, safeMultiplicativeValue(normalizedNewValue), numSteps);
 		break;
 	}
+	// -- jumps straight to the target when the ramp length is 0
+	updateCurrentValue(controlID);
 }
 
-//==============================================================================
-// -- PARAMETERS CREATION
-//==============================================================================
-// -- BOOL
-inline void PluginStateManager::addParam(
-	juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-	ControlID controlID,
-	juce::String id,
-	int versionHint,
-	const juce::String& name,
-	bool defaultValue,
-	const juce::String& suffixLabel,
-	SmoothingType smoothingType,
-	double rampLengthInSeconds
-)
+// -- Memory
+MemoryFootprint PluginStateManager::getMemoryFootprint()
 {
-	layout.add(
-		std::make_unique<juce::AudioParameterBool>(
-			juce::ParameterID{ id, versionHint },
-			name,
-			defaultValue,
-			juce::AudioParameterBoolAttributes().withLabel(suffixLabel)
-		)
-	);
-	parameterIDs[controlID] = id;
-	parameterTypes[controlID] = ParameterType::Bool;
-	addSmoothedValue(controlID, smoothingType, defaultValue, rampLengthInSeconds);
+	MemoryFootprint footprint;
+	footprint.add("object", sizeof(PluginStateManager)); // -- parameter objects and smoother banks are held inline
+	footprint.add("smoothedBlocks", static_cast<size_t>(ControlID::countParams) * static_cast<size_t>(smoothedBlockSize) * sizeof(float));
+	return footprint;
 }
-// -- CHOICE CONSTRUCTOR
-inline void PluginStateManager::addParam(
-	juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-	ControlID controlID,
-	juce::String id,
-	int versionHint,
-	const juce::String& name,
-	const juce::StringArray& choices,
-	int defaultItemIndex,
-	const juce::String& suffixLabel,
-	SmoothingType smoothingType,
-	double rampLengthInSeconds
-)
+
+//==============================================================================
+void PluginStateManager::publishParameterSnapshot(const std::array<float, ControlID::countParams>& plainValues, double rampLengthInSeconds)
 {
-	layout.add(
-		std::make_unique<juce::AudioParameterChoice>(
-			juce::ParameterID{ id, versionHint },
-			name,
-			choices,
-			defaultItemIndex,
-			juce::AudioParameterChoiceAttributes().withLabel(suffixLabel)
-		)
-	);
-	parameterIDs[controlID] = id;
-	parameterTypes[controlID] = ParameterType::Choice;
-	addSmoothedValue(controlID, smoothingType, defaultItemIndex, rampLengthInSeconds);
+	auto snapshot = std::make_unique<ParameterSnapshot>();
+	snapshot->rampLengthInSeconds = rampLengthInSeconds;
+	for (int i{ 0 }; i < ControlID::countParams; i++)
+	{
+		// -- same values updateInBoundVariable would read once the parameters are set
+		const auto& descriptor = ParameterDescriptors::table[i];
+		float value = juce::jlimit(descriptor.range.start, descriptor.range.end, plainValues[i]);
+		switch (descriptor.type)
+		{
+		case ParameterType::Bool:
+			value = value >= 0.5f ? 1.f : 0.f;
+			break;
+		case ParameterType::Choice:
+		case ParameterType::Int:
+			value = static_cast<float>(juce::roundToInt(value));
+			break;
+		case ParameterType::Float:
+			break;
+		}
+		snapshot->values[i] = value;
+	}
+
+	// -- free what the audio thread is done with, then replace a snapshot it has not picked up yet
+	delete retiredSnapshot.exchange(nullptr, std::memory_order_acquire);
+	delete pendingSnapshot.exchange(snapshot.release(), std::memory_order_acq_rel);
 }
-// -- FLOAT CONSTRUCTOR
-inline void PluginStateManager::addParam(
-	juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-	ControlID controlID,
-	juce::String id,
-	int versionHint,
-	const juce::String& name,
-	const juce::NormalisableRange<float>& floatRange,
-	float defaultValue,
-	const juce::String& suffixLabel,
-	SmoothingType smoothingType,
-	double rampLengthInSeconds
-)
+
+void PluginStateManager::restoreParameterValues(const std::array<float, ControlID::countParams>& plainValues, double rampLengthInSeconds)
 {
-	layout.add(
-		std::make_unique<juce::AudioParameterFloat>(
-			juce::ParameterID{ id, versionHint },
-			name,
-			floatRange,
-			defaultValue,
-			juce::AudioParameterFloatAttributes().withLabel(suffixLabel)
-		)
-	);
-	parameterIDs[controlID] = id;
-	parameterTypes[controlID] = ParameterType::Float;
-	addSmoothedValue(controlID, smoothingType, defaultValue, rampLengthInSeconds);
+	publishParameterSnapshot(plainValues, rampLengthInSeconds);
+
+	// -- same as APVTS::replaceState, only the parameters that changed notify the host and the listeners
+	for (int i{ 0 }; i < ControlID::countParams; i++)
+	{
+		auto* parameter = parameters[i].getParameter();
+		const float normalisedValue = parameter->convertTo0to1(plainValues[i]);
+		if (!juce::approximatelyEqual(normalisedValue, parameter->getValue()))
+		{
+			parameter->setValueNotifyingHost(normalisedValue);
+		}
+	}
 }
-// -- INT CONSTRUCTOR
-inline void PluginStateManager::addParam(
-	juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-	ControlID controlID,
-	juce::String id,
-	int versionHint,
-	const juce::String& name,
-	int minValue,
-	int maxValue,
-	int defaultValue,
-	const juce::String& suffixLabel,
-	SmoothingType smoothingType,
-	double rampLengthInSeconds
-)
+
+std::array<float, ControlID::countParams> PluginStateManager::getParameterValues()
 {
-	layout.add(
-		std::make_unique<juce::AudioParameterInt>(
-			juce::ParameterID{ id, versionHint },
-			name,
-			minValue,
-			maxValue,
-			defaultValue,
-			juce::AudioParameterIntAttributes().withLabel(suffixLabel)
-		)
-	);
-	parameterIDs[controlID] = id;
-	parameterTypes[controlID] = ParameterType::Int;
-	addSmoothedValue(controlID, smoothingType, defaultValue, rampLengthInSeconds);
+	// -- the parameter holds the value the host last set, whatever the audio thread synced
+	std::array<float, ControlID::countParams> values{};
+	for (int i{ 0 }; i < ControlID::countParams; i++)
+	{
+		auto* parameter = parameters[i].getParameter();
+		values[i] = parameter->convertFrom0to1(parameter->getValue());
+	}
+	return values;
 }
 
 //==============================================================================
-void PluginStateManager::syncInBoundVariables()
+void PluginStateManager::syncInBoundVariables(int numSamples)
 {
-	for (int i{ 0 }; i < ControlID::countParams; i++)
+	adoptParameterSnapshot();
+	syncParameters(numSamples, dirtyParameters.take(), nullptr);
+}
+
+void PluginStateManager::syncInBoundVariables(int numSamples, const std::array<float, ControlID::countParams>& inBoundValues)
+{
+	// -- a replayed block is a full snapshot, compare every value
+	syncParameters(numSamples, DirtyBitset<ControlID::countParams>::makeRange(0, ControlID::countParams), &inBoundValues);
+}
+
+void PluginStateManager::syncParameters(int numSamples, ParameterBits changedParameters, const std::array<float, ControlID::countParams>* inBoundValues)
+{
+	syncParameterGroups(changedParameters, inBoundValues);
+
+	DirtyBitset<ControlID::countParams>::forEachSetBit(changedParameters, [this, inBoundValues](int i)
+		{
+			float lastValue = parameters[i].getInBoundVariable();
+			float newValue = readInBoundVariable(i, inBoundValues);
+			if (!juce::approximatelyEqual(lastValue, newValue))
+			{
+				setTargetValue(intToEnum(i, ControlID), newValue);
+			}
+		});
+	advanceSmoothedValues(numSamples);
+}
+
+void PluginStateManager::syncParameterGroups(ParameterBits& changedParameters, const std::array<float, ControlID::countParams>* inBoundValues)
+{
+	for (int g{ 0 }; g < ParameterGroupID::countGroups; g++)
 	{
-		float lastValue = parameters[i]->getInBoundVariable();
-		float newValue = parameters[i]->updateInBoundVariable();
-		updateSmoothingValue(intToEnum(i, ControlID), lastValue, newValue);
+		const auto& group = ParameterDescriptors::groups[g];
+		if (group.bypassID == ControlID::countParams)
+		{
+			continue;
+		}
+
+		// -- the bypass is always synced, and first, it decides for the rest of the group
+		if (DirtyBitset<ControlID::countParams>::test(changedParameters, group.bypassID))
+		{
+			DirtyBitset<ControlID::countParams>::clear(changedParameters, group.bypassID);
+			float lastValue = parameters[group.bypassID].getInBoundVariable();
+			float newValue = readInBoundVariable(group.bypassID, inBoundValues);
+			if (!juce::approximatelyEqual(lastValue, newValue))
+			{
+				setTargetValue(group.bypassID, newValue);
+			}
+		}
+
+		// -- suspend once the bypass ramp is over, resume as soon as the bypass is released
+		bool isBypassed = parameters[group.bypassID].getBoolValue() && currentValues[group.bypassID] >= 1.f;
+		if (!isBypassed && !suspendedGroups[g])
+		{
+			continue;
+		}
+
+		// -- the rest of the group leaves the regular sync
+		const auto& mask = groupMasks[g];
+		ParameterBits groupParameters{};
+		for (size_t w{ 0 }; w < changedParameters.size(); w++)
+		{
+			groupParameters[w] = changedParameters[w] & mask[w];
+			changedParameters[w] &= ~mask[w];
+		}
+
+		if (isBypassed)
+		{
+			if (!suspendedGroups[g])
+			{
+				// -- stop the ramps still running, nothing reads them until the group resumes
+				suspendedGroups[g] = true;
+				for (int i{ group.firstID }; i < group.endID; i++)
+				{
+					if (i != group.bypassID)
+					{
+						setCurrentAndTargetValue(intToEnum(i, ControlID), parameters[i].getFloatValue());
+					}
+				}
+			}
+			for (size_t w{ 0 }; w < pendingParameters.size(); w++)
+			{
+				pendingParameters[w] |= groupParameters[w];
+			}
+			continue;
+		}
+
+		// -- resume, everything that changed meanwhile jumps to its value, the stage fades in with its bypass
+		suspendedGroups[g] = false;
+		for (size_t w{ 0 }; w < pendingParameters.size(); w++)
+		{
+			groupParameters[w] |= pendingParameters[w] & mask[w];
+			pendingParameters[w] &= ~mask[w];
+		}
+		DirtyBitset<ControlID::countParams>::forEachSetBit(groupParameters, [this, inBoundValues](int i)
+			{
+				setCurrentAndTargetValue(intToEnum(i, ControlID), readInBoundVariable(i, inBoundValues));
+			});
 	}
 }
 
-void PluginStateManager::updateSmoothingValue(ControlID controlID, float lastValue, float newValue)
+void PluginStateManager::adoptParameterSnapshot()
 {
-	SmoothingType smoothingType = smoothingTypes[controlID];
-	if (smoothingType == SmoothingType::NoSmoothing)
+	// -- hand the last snapshot back first, a new one waits a block if the message thread has not freed the previous yet
+	if (adoptedSnapshot != nullptr)
 	{
-		return;
+		ParameterSnapshot* expected{ nullptr };
+		if (!retiredSnapshot.compare_exchange_strong(expected, adoptedSnapshot, std::memory_order_release, std::memory_order_relaxed))
+		{
+			return;
+		}
+		adoptedSnapshot = nullptr;
 	}
 
-	int idx = smoothingValueIndexes[controlID];
-	bool valueChanged = !juce::approximatelyEqual(lastValue, newValue);
-	// Need to normalize the inBound variable to the range [0, 1] first
-	float normalizedNewValue = valueChanged ? parameters[controlID]->getParameterRange().convertTo0to1(newValue) : 0.f;
-	switch (smoothingType)
+	adoptedSnapshot = pendingSnapshot.exchange(nullptr, std::memory_order_acquire);
+	if (adoptedSnapshot == nullptr)
 	{
-	case SmoothingType::Linear:
+		return;
+	}
+
+	// -- the whole state lands in this block, the parameter changes that follow read the same values and do nothing
+	const int numSteps = static_cast<int>(std::floor(adoptedSnapshot->rampLengthInSeconds * sampleRate));
+	for (int i{ 0 }; i < ControlID::countParams; i++)
 	{
-		auto& smoothedValue = linearSmoothedValues[idx].smoothedValue;
-		if (valueChanged)
+		float value = parameters[i].setInBoundVariable(adoptedSnapshot->values[i]);
+		if (numSteps > 0)
 		{
-			smoothedValue.setTargetValue(normalizedNewValue);
+			// -- non smoothed parameters jump at the start of the morph
+			setTargetValue(intToEnum(i, ControlID), value, numSteps);
 		}
-		smoothedValue.getNextValue();
-		break;
-	}
-	case SmoothingType::Multiplicative:
-	{
-		auto& smoothedValue = multiplicativeSmoothedValues[idx].smoothedValue;
-		if (valueChanged)
+		else
 		{
-			smoothedValue.setTargetValue(safeMultiplicativeValue(normalizedNewValue));
+			setCurrentAndTargetValue(intToEnum(i, ControlID), value);
 		}
-		smoothedValue.getNextValue();
-		break;
 	}
+}
+
+float PluginStateManager::readInBoundVariable(int index, const std::array<float, ControlID::countParams>* inBoundValues)
+{
+	if (inBoundValues == nullptr)
+	{
+		return parameters[index].updateInBoundVariable();
+	}
+
+	float lastValue = parameters[index].getInBoundVariable();
+	float newValue = parameters[index].setInBoundVariable((*inBoundValues)[index]);
+	if (!juce::approximatelyEqual(lastValue, newValue))
+	{
+		// -- the replayed value now hides the parameter, re-read it once live syncing resumes
+		dirtyParameters.mark(static_cast<size_t>(index));
 	}
+	return newValue;
 }
 
-//==============================================================================
-template<typename T>
-inline void PluginStateManager::addSmoothedValue(
-	ControlID controlID,
-	SmoothingType smoothingType,
-	T initialValue,
-	double rampLengthInSeconds
-)
+void PluginStateManager::advanceSmoothedValues(int numSamples)
 {
-	smoothingTypes[controlID] = smoothingType;
-	if (smoothingType == SmoothingType::NoSmoothing)
+	// -- one pass per bank, parameters that are not ramping stay where they are
+	linearSmoothers.advance(numSamples);
+	multiplicativeSmoothers.advance(numSamples);
+
+	// -- only the ramps that moved need their plain value again
+	for (int i{ 0 }; i < ParameterDescriptors::numLinearSmoothed; i++)
 	{
-		smoothingValueIndexes[controlID] = -1;
-		return;
+		if (linearSmoothers.wasSmoothing(i))
+		{
+			updateCurrentValue(ParameterDescriptors::linearSmoothedControlIDs[i]);
+		}
 	}
+	for (int i{ 0 }; i < ParameterDescriptors::numMultiplicativeSmoothed; i++)
+	{
+		if (multiplicativeSmoothers.wasSmoothing(i))
+		{
+			updateCurrentValue(ParameterDescriptors::multiplicativeSmoothedControlIDs[i]);
+		}
+	}
+}
 
-	float initialValAsFloat = static_cast<float>(initialValue);
-	int idx;
-	switch (smoothingType)
+void PluginStateManager::updateCurrentValue(ControlID controlID)
+{
+	const auto& descriptor = ParameterDescriptors::get(controlID);
+	int idx = ParameterDescriptors::smoothingIndexes[controlID];
+	float normalizedValue = 0.f;
+	switch (descriptor.smoothingType)
 	{
 	case SmoothingType::Linear:
-	{
-		idx = linearSmoothedValues.size();
-		SmoothedValue<juce::LinearSmoothedValue<float>> linearSmoothedValue(
-			controlID,
-			juce::LinearSmoothedValue<float>(initialValAsFloat),
-			rampLengthInSeconds
-		);
-		linearSmoothedValues.push_back(linearSmoothedValue);
+		normalizedValue = linearSmoothers.getCurrentValue(idx);
 		break;
-	}
 	case SmoothingType::Multiplicative:
-	{
-		int idx = multiplicativeSmoothedValues.size();
-		SmoothedValue<juce::SmoothedValue<float, Multiplicative>> multiplicativeSmoothedValue(
-			controlID,
-			juce::SmoothedValue<float, Multiplicative>(safeMultiplicativeValue(initialValAsFloat)),
-			rampLengthInSeconds
-		);
-		multiplicativeSmoothedValues.push_back(multiplicativeSmoothedValue);
+		normalizedValue = multiplicativeSmoothers.getCurrentValue(idx);
 		break;
+	default:
+		// -- not smoothed, the setters store the plain value directly
+		return;
 	}
-	}
-	smoothingValueIndexes[controlID] = idx;
+	// Denormalize value to the selected range
+	currentValues[controlID] = ParameterDescriptors::convertFrom0to1(descriptor.range, normalizedValue);
+}
+
+//==============================================================================
+void PluginStateManager::ParameterChangeListener::parameterChanged(const juce::String& /*parameterID*/, float /*newValue*/)
+{
+	// -- may run on any thread (host automation, UI, setStateInformation), only flag the change
+	dirtyParameters->mark(static_cast<size_t>(controlID));
 }
 
 //==============================================================================
@@ -509,716 +605,54 @@ inline float PluginStateManager::safeMultiplicativeValue(float value, float smal
 	return juce::approximatelyEqual(value, 0.f) ? smallestValue : value;
 }
 
-inline float PluginStateManager::safeDenormalizableValue(float value)
-{
-	return juce::jlimit(0.f, 1.f, value);
-}
-
 //==============================================================================
-juce::AudioProcessorValueTreeState::ParameterLayout PluginStateManager::initParamsAndCreateLayout()
+juce::AudioProcessorValueTreeState::ParameterLayout PluginStateManager::createParameterLayout()
 {
 	juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-	//==============================================================================
-	// -- ranges
-	auto gainRange = juce::NormalisableRange<float>(-24.f, 24.f, .01f);
-	auto freqRange = juce::NormalisableRange<float>(20.f, 20000.f, 1.f, .198893842f);
-	auto filterQRange = juce::NormalisableRange<float>(.1f, 10.f, .05f, 1.f);
-	auto thresholdRange = juce::NormalisableRange<float>(-60.f, 24.f, 1.f, 1.f);
-	auto attackReleaseRange = juce::NormalisableRange<float>(5.f, 500.f, 1.f, 1.f);
-	auto ratioRange = juce::NormalisableRange<float>(1.f, 100.f, .1f, .4f);
-
-	//==============================================================================
-	// -- choices
-	juce::StringArray freqPassSlopeChoices;
-	for (int i{ 0 }; i < 4; ++i)
+	for (const auto& descriptor : ParameterDescriptors::table)
 	{
-		juce::String str;
-		str << (12 + i * 12);
-		str << " db/Oct";
-		freqPassSlopeChoices.add(str);
+		layout.add(createParameter(descriptor));
 	}
-
-	//==============================================================================
-	// -- Bypass ALL
-	addParam(
-		layout,
-		ControlID::bypass,
-		"bypass",
-		V1_0_0,
-		"bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-	// -- Blend (dry/wet)
-	addParam(
-		layout,
-		ControlID::blend,
-		"blend",
-		V1_0_0,
-		"blend",
-		juce::NormalisableRange<float>(0.f, 1.f, .01f),
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-	// -- Pre Gain
-	addParam(
-		layout,
-		ControlID::preGain,
-		"preGain",
-		V1_0_0,
-		"pre-gain",
-		gainRange,
-		0.f,
-		"dB",
-		SmoothingType::NoSmoothing // -- Gain DSP module already has smoothing
-	);
-
-	//==============================================================================
-	// -- Multi Band EQ -- HPF, LPF, 3 Band 
-	// -- HPF
-	addParam(
-		layout,
-		ControlID::highpassBypass,
-		"highpassBypass",
-		V1_0_0,
-		"hpf bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::highpassFreq,
-		"highpassFreq",
-		V1_0_0,
-		"hpf freq",
-		freqRange,
-		20.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::highpassSlope,
-		"highpassSlope",
-		V1_0_0,
-		"hpf slope",
-		freqPassSlopeChoices
-	);
-	// -- LPF
-	addParam(
-		layout,
-		ControlID::lowpassBypass,
-		"lowpassBypass",
-		V1_0_0,
-		"lpf bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::lowpassFreq,
-		"lowpassFreq",
-		V1_0_0,
-		"lpf freq",
-		freqRange,
-		20000.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::lowpassSlope,
-		"lowpassSlope",
-		V1_0_0,
-		"lpf slope",
-		freqPassSlopeChoices
-	);
-	// -- Band Filter 1
-	addParam(
-		layout,
-		ControlID::bandFilter1Bypass,
-		"bandFilter1Bypass",
-		V1_0_0,
-		"bpf1 bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter1PeakFreq,
-		"bandFilter1PeakFreq",
-		V1_0_0,
-		"bpf1 freq",
-		freqRange,
-		750.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter1PeakGain,
-		"bandFilter1PeakGain",
-		V1_0_0,
-		"bpf1 gain",
-		gainRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter1PeakQ,
-		"bandFilter1PeakQ",
-		V1_0_0,
-		"bpf1 Q",
-		filterQRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-	// -- Band Filter 2
-	addParam(
-		layout,
-		ControlID::bandFilter2Bypass,
-		"bandFilter2Bypass",
-		V1_0_0,
-		"bpf2 bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter2PeakFreq,
-		"bandFilter2PeakFreq",
-		V1_0_0,
-		"bpf2 freq",
-		freqRange,
-		2000.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter2PeakGain,
-		"bandFilter2PeakGain",
-		V1_0_0,
-		"bpf2 gain",
-		gainRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter2PeakQ,
-		"bandFilter2PeakQ",
-		V1_0_0,
-		"bpf2 Q",
-		filterQRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-	// -- Band Filter 3
-	addParam(
-		layout,
-		ControlID::bandFilter3Bypass,
-		"bandFilter3Bypass",
-		V1_0_0,
-		"bpf3 bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter3PeakFreq,
-		"bandFilter3PeakFreq",
-		V1_0_0,
-		"bpf3 freq",
-		freqRange,
-		4000.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter3PeakGain,
-		"bandFilter3PeakGain",
-		V1_0_0,
-		"bpf3 gain",
-		gainRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::bandFilter3PeakQ,
-		"bandFilter3PeakQ",
-		V1_0_0,
-		"bpf3 Q",
-		filterQRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	//==============================================================================
-	addParam(
-		layout,
-		ControlID::compressorBypass,
-		"compressorBypass",
-		V1_0_0,
-		"compressor bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-	// -- Multi Band Compressor
-	addParam(
-		layout,
-		ControlID::lowMidCrossoverFreq,
-		"lowMidCrossoverFreq",
-		V1_0_0,
-		"low-mid crossover freq",
-		juce::NormalisableRange<float>(20.f, 999.f, 1.f, .198893842f),
-		400.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::midHighCrossoverFreq,
-		"midHighCrossoverFreq",
-		V1_0_0,
-		"mid-high crossover freq",
-		juce::NormalisableRange<float>(1000.f, 20000.f, 1.f, .198893842f),
-		2000.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-	// -- Low Band Compressor
-	addParam(
-		layout,
-		ControlID::lowBandCompressorMute,
-		"lowBandCompressorMute",
-		V1_0_0,
-		"low band mute",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::lowBandCompressorBypass,
-		"lowBandCompressorBypass",
-		V1_0_0,
-		"low band bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::lowBandCompressorThreshold,
-		"lowBandCompressorThreshold",
-		V1_0_0,
-		"low band threshold",
-		thresholdRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::lowBandCompressorAttack,
-		"lowBandCompressorAttack",
-		V1_0_0,
-		"low band attack",
-		attackReleaseRange,
-		50.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::lowBandCompressorRelease,
-		"lowBandCompressorRelease",
-		V1_0_0,
-		"low band release",
-		attackReleaseRange,
-		250.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::lowBandCompressorRatio,
-		"lowBandCompressorRatio",
-		V1_0_0,
-		"low band ratio",
-		ratioRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-	// -- Mid Band Compressor
-	addParam(
-		layout,
-		ControlID::midBandCompressorMute,
-		"midBandCompressorMute",
-		V1_0_0,
-		"mid band mute",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::midBandCompressorBypass,
-		"midBandCompressorBypass",
-		V1_0_0,
-		"mid band bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::midBandCompressorThreshold,
-		"midBandCompressorThreshold",
-		V1_0_0,
-		"mid band threshold",
-		thresholdRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::midBandCompressorAttack,
-		"midBandCompressorAttack",
-		V1_0_0,
-		"mid band attack",
-		attackReleaseRange,
-		50.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::midBandCompressorRelease,
-		"midBandCompressorRelease",
-		V1_0_0,
-		"mid band release",
-		attackReleaseRange,
-		250.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::midBandCompressorRatio,
-		"midBandCompressorRatio",
-		V1_0_0,
-		"mid band ratio",
-		ratioRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-	// -- High Band Compressor
-	addParam(
-		layout,
-		ControlID::highBandCompressorMute,
-		"highBandCompressorMute",
-		V1_0_0,
-		"high band mute",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::highBandCompressorBypass,
-		"highBandCompressorBypass",
-		V1_0_0,
-		"high band bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::highBandCompressorThreshold,
-		"highBandCompressorThreshold",
-		V1_0_0,
-		"high band threshold",
-		thresholdRange,
-		0.f,
-		"dB",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::highBandCompressorAttack,
-		"highBandCompressorAttack",
-		V1_0_0,
-		"high band attack",
-		attackReleaseRange,
-		50.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::highBandCompressorRelease,
-		"highBandCompressorRelease",
-		V1_0_0,
-		"high band release",
-		attackReleaseRange,
-		250.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::highBandCompressorRatio,
-		"highBandCompressorRatio",
-		V1_0_0,
-		"high band ratio",
-		ratioRange,
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	//==============================================================================
-	// -- Imager
-	addParam(
-		layout,
-		ControlID::imagerBypass,
-		"imagerBypass",
-		V1_0_0,
-		"imager bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		.01f
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerOriginalGain,
-		"imagerOriginalGain",
-		V1_0_0,
-		"imager original gain",
-		juce::NormalisableRange<float>(0.f, 2.f, .001f),
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerAuxiliarGain,
-		"imagerAuxiliarGain",
-		V1_0_0,
-		"imager aux gain",
-		juce::NormalisableRange<float>(0.f, 2.f, .001f),
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerWidth,
-		"imagerWidth",
-		V1_0_0,
-		"imager width",
-		juce::NormalisableRange<float>(-1.f, 1.f, .001f),
-		.5f,
-		"",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerCenter,
-		"imagerCenter",
-		V1_0_0,
-		"imager center",
-		juce::NormalisableRange<float>(-1.f, 1.f, .001f),
-		0.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerDelayTime,
-		"imagerDelayTime",
-		V1_0_0,
-		"imager delay time",
-		juce::NormalisableRange<float>(0.f, 50.f, .001f, .7f),
-		4.f,
-		"ms",
-		SmoothingType::Linear
-	);
-
-	addParam(
-		layout,
-		ControlID::imagerCrossoverFreq,
-		"imagerCrossoverFreq",
-		V1_0_0,
-		"imager crossover freq",
-		freqRange,
-		300.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	juce::StringArray imagerTypeChoices{ "Haas", "Haas - mono cancelation", "Haas - mid/side processing" };
-	addParam(
-		layout,
-		ControlID::imagerType,
-		"imagerType",
-		V1_0_0,
-		"imager type",
-		imagerTypeChoices
-	);
-
-	//==============================================================================
-	// -- Phaser
-	addParam(
-		layout,
-		ControlID::phaserBypass,
-		"phaserBypass",
-		V1_0_0,
-		"phaser bypass",
-		false,
-		"",
-		SmoothingType::Linear,
-		0.01f
-	);
-
-	// -- Phaser LFO
-	// -- LFO rate -- (0, 100) Hz
-	addParam(
-		layout,
-		ControlID::phaserRate,
-		"phaserRate",
-		V1_0_0,
-		"phaser rate",
-		juce::NormalisableRange<float>(0.f, 99.999f, .001f, .35f), // TODO: check skew factor
-		1.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	// -- LFO depth -- (0, 1)
-	addParam(
-		layout,
-		ControlID::phaserDepth,
-		"phaserDepth",
-		V1_0_0,
-		"phaser depth",
-		juce::NormalisableRange<float>(0.f, 1.f, .001f, .5f),
-		.5f,
-		"",
-		SmoothingType::Linear
-	);
-
-	// -- Phaser Filter -- Centre Frequency -- (20, 20000) Hz
-	addParam(
-		layout,
-		ControlID::phaserCentreFrequency,
-		"phaserCentreFrequency",
-		V1_0_0,
-		"phaser center freq",
-		freqRange,
-		1300.f,
-		"Hz",
-		SmoothingType::Linear
-	);
-
-	// -- Phaser other params
-	// -- Feedback -- (-1, 1)
-	addParam(
-		layout,
-		ControlID::phaserFeedback,
-		"phaserFeedback",
-		V1_0_0,
-		"phaser feedback",
-		juce::NormalisableRange<float>(-1.f, 1.f, 0.01f),
-		0.f,
-		"",
-		SmoothingType::Linear
-	);
-
-	// -- Mix -- (0, 1)
-	addParam(
-		layout,
-		ControlID::phaserMix,
-		"phaserMix",
-		V1_0_0,
-		"phaser mix",
-		juce::NormalisableRange<float>(0.f, 1.f, .01f),
-		.5f,
-		"",
-		SmoothingType::Linear
-	);
-
 	return layout;
 }
+
+std::unique_ptr<juce::RangedAudioParameter> PluginStateManager::createParameter(const ParameterDescriptor& descriptor)
+{
+	juce::ParameterID parameterID{ descriptor.id, descriptor.versionHint };
+	switch (descriptor.type)
+	{
+	case ParameterType::Bool:
+		return std::make_unique<juce::AudioParameterBool>(
+			parameterID,
+			descriptor.name,
+			descriptor.defaultValue >= 0.5f,
+			juce::AudioParameterBoolAttributes().withLabel(descriptor.suffixLabel)
+		);
+	case ParameterType::Choice:
+		return std::make_unique<juce::AudioParameterChoice>(
+			parameterID,
+			descriptor.name,
+			juce::StringArray(descriptor.choices.items, descriptor.choices.numItems),
+			juce::roundToInt(descriptor.defaultValue),
+			juce::AudioParameterChoiceAttributes().withLabel(descriptor.suffixLabel)
+		);
+	case ParameterType::Int:
+		return std::make_unique<juce::AudioParameterInt>(
+			parameterID,
+			descriptor.name,
+			juce::roundToInt(descriptor.range.start),
+			juce::roundToInt(descriptor.range.end),
+			juce::roundToInt(descriptor.defaultValue),
+			juce::AudioParameterIntAttributes().withLabel(descriptor.suffixLabel)
+		);
+	case ParameterType::Float:
+	default:
+		return std::make_unique<juce::AudioParameterFloat>(
+			parameterID,
+			descriptor.name,
+			juce::NormalisableRange<float>(descriptor.range.start, descriptor.range.end, descriptor.range.interval, descriptor.range.skew),
+			descriptor.defaultValue,
+			juce::AudioParameterFloatAttributes().withLabel(descriptor.suffixLabel)
+		);
+	}
+}
@@ -11,9 +11,14 @@
 #include <JuceHeader.h>
 #include <map>
 #include <array>
+#include <atomic>
 #include <memory>
 #include "parameterTypes.h"
 #include "ParameterObject.h"
+#include "ParameterDescriptors.h"
+#include "MemoryFootprint.h"
+#include "DirtyBitset.h"
+#include "SmootherBank.h"
 
 //==============================================================================
 class PluginStateManager
@@ -22,23 +27,17 @@ public:
 	//==============================================================================
 	// -- CONSTRUCTORS
 	//==============================================================================
+	// -- Owns the APVTS, build it in place (std::make_shared) -- it cannot be copied or moved
 	PluginStateManager(juce::AudioProcessor& processorToConnectTo, juce::UndoManager* undoManagerToUse, const juce::Identifier& valueTreeType);
 	~PluginStateManager();
 
-	//==============================================================================
-	PluginStateManager(const PluginStateManager&); // copy constructor
-	PluginStateManager(PluginStateManager&&) noexcept; // move constructor
-
-	PluginStateManager& operator=(const PluginStateManager& other); // copy assignment
-	PluginStateManager& operator=(PluginStateManager&& other) noexcept; // move assignment
-
 	//==============================================================================
 	// --- APVTS
 	juce::AudioProcessorValueTreeState* getAPVTS();
 
 	// -- Parameters
 	void attachParameters(const juce::AudioProcessorValueTreeState& apvts);
-	std::shared_ptr<ParameterObject> getParameterObject(ControlID controlID);
+	ParameterObject& getParameterObject(ControlID controlID);
 	juce::RangedAudioParameter* getParameter(ControlID controlID);
 
 	// -- Inbound Values
@@ -50,130 +49,112 @@ public:
 	int getIntValue(ControlID controlID);
 
 	// -- Smoothing
-	void initSmoothedValues(double sampleRate);
+	void initSmoothedValues(double sampleRate, int maximumBlockSize);
 	void resetSmoothedValues(double sampleRate);
 	void reset(ControlID controlID, double sampleRate, double rampLengthInSeconds = 0.005f);
 
 	float getCurrentValue(ControlID controlID);
+	const float* getCurrentValueSlot(ControlID controlID); // -- ParameterHandle reads the cache through it
 	float getNextValue(ControlID controlID);
+	// -- Per-sample values of the current block, plain (denormalised) units, valid until the next sync.
+	// -- Fills at most getSmoothedBlockCapacity() samples, longer blocks have to be asked for in pieces;
+	// -- before initSmoothedValues there is no storage and it returns the current value, one sample
+	const float* getSmoothedBlock(ControlID controlID, int numSamples);
+	int getSmoothedBlockCapacity() const;
 
 	void setCurrentAndTargetValue(ControlID controlID, float newValue);
-	void setTargetValue(ControlID controlID, float newValue);
+	void setTargetValue(ControlID controlID, float newValue, int numSteps = -1); // -- numSteps < 0 uses the parameter's ramp length
+
+	// -- Memory -- the APVTS and its parameters are not sized
+	MemoryFootprint getMemoryFootprint();
 
 	//==============================================================================
-	// -- PARAMETERS CREATION
-	//==============================================================================
-	// -- BOOL CONSTRUCTOR
-	void addParam(
-		juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-		ControlID controlID,
-		juce::String id,
-		int versionHint,
-		const juce::String& name,
-		bool defaultValue = false,
-		const juce::String& suffixLabel = "",
-		SmoothingType smoothingType = SmoothingType::NoSmoothing,
-		double rampLengthInSeconds = 0.005f
-	);
-	// -- CHOICE CONSTRUCTOR
-	void addParam(
-		juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-		ControlID controlID,
-		juce::String id,
-		int versionHint,
-		const juce::String& name,
-		const juce::StringArray& choices,
-		int defaultItemIndex = 0,
-		const juce::String& suffixLabel = "",
-		SmoothingType smoothingType = SmoothingType::NoSmoothing,
-		double rampLengthInSeconds = 0.005f
-	);
-	// -- FLOAT CONSTRUCTOR
-	void addParam(
-		juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-		ControlID controlID,
-		juce::String id,
-		int versionHint,
-		const juce::String& name,
-		const juce::NormalisableRange<float>& floatRange,
-		float defaultValue = 0.f,
-		const juce::String& suffixLabel = "",
-		SmoothingType smoothingType = SmoothingType::NoSmoothing,
-		double rampLengthInSeconds = 0.005f
-	);
-	// -- INT CONSTRUCTOR
-	void addParam(
-		juce::AudioProcessorValueTreeState::ParameterLayout& layout,
-		ControlID controlID,
-		juce::String id,
-		int versionHint,
-		const juce::String& name,
-		int minValue,
-		int maxValue,
-		int defaultValue = 0,
-		const juce::String& suffixLabel = "",
-		SmoothingType smoothingType = SmoothingType::NoSmoothing,
-		double rampLengthInSeconds = 0.005f
-	);
+	// -- State restores -- message thread, call before setting the parameters themselves
+	// -- the next sync jumps every parameter to the snapshot at once instead of ramping them as their changes come in
+	// -- with a ramp length, smoothed parameters all ramp to it together over that time instead (preset morphs)
+	void publishParameterSnapshot(const std::array<float, ControlID::countParams>& plainValues, double rampLengthInSeconds = 0.0);
+	// -- Publishes the snapshot, then sets the parameters that differ (host and UI follow)
+	void restoreParameterValues(const std::array<float, ControlID::countParams>& plainValues, double rampLengthInSeconds = 0.0);
+	// -- Plain values the parameters hold now, message thread
+	std::array<float, ControlID::countParams> getParameterValues();
 
 	//==============================================================================
-	void syncInBoundVariables();
+	// -- Only reads the parameters that changed since the last call, then advances every smoother bank by the block
+	// -- a bypassed stage (ParameterDescriptors::groups) only syncs its bypass, the rest catches up in one step when it is re-enabled
+	void syncInBoundVariables(int numSamples);
+	void syncInBoundVariables(int numSamples, const std::array<float, ControlID::countParams>& inBoundValues); // -- replays values instead of reading the parameters
 private:
 	//==============================================================================
-	// --- Parameters
-	std::array<juce::String, ControlID::countParams> parameterIDs;
-	std::array<ParameterType, ControlID::countParams> parameterTypes;
 	// --- Parameter Objects holds the actual parameters and its inbound values
-	std::array<std::shared_ptr<ParameterObject>, ControlID::countParams> parameters;
+	std::array<ParameterObject, ControlID::countParams> parameters;
 
 	//==============================================================================
-	// -- Smoothing variables
-	using Multiplicative = juce::ValueSmoothingTypes::Multiplicative;
+	// -- Smoothing variables, normalised [0, 1] values
+	// -- banks sized by ParameterDescriptors, ControlID -> bank index is ParameterDescriptors::smoothingIndexes
+	SmootherBank<ParameterDescriptors::numLinearSmoothed, SmoothingType::Linear> linearSmoothers;
+	SmootherBank<ParameterDescriptors::numMultiplicativeSmoothed, SmoothingType::Multiplicative> multiplicativeSmoothers;
+	// -- getSmoothedBlock storage, maximumBlockSize samples per ControlID, allocated in initSmoothedValues
+	juce::HeapBlock<float> smoothedBlocks;
+	int smoothedBlockSize{ 0 };
+	double sampleRate{ 0.0 };
+	// -- getCurrentValue cache, plain (denormalised) values
+	std::array<float, ControlID::countParams> currentValues{};
 
-	template <typename T>
-	struct SmoothedValue
+	//==============================================================================
+	// -- Change tracking
+	// -- set by the parameter listeners (any thread), taken by syncInBoundVariables
+	DirtyBitset<ControlID::countParams> dirtyParameters;
+	using ParameterBits = DirtyBitset<ControlID::countParams>::Words;
+
+	// -- Stage groups
+	std::array<ParameterBits, ParameterGroupID::countGroups> groupMasks;
+	std::array<bool, ParameterGroupID::countGroups> suspendedGroups{};
+	// -- changed while their group was suspended, read when it resumes
+	ParameterBits pendingParameters{};
+
+	// -- APVTS listeners are called once the raw parameter value is stored, so reading it after taking the bit is never stale
+	struct ParameterChangeListener : public juce::AudioProcessorValueTreeState::Listener
 	{
-		SmoothedValue(ControlID controlID, T smoothedValue, double rampLengthInSeconds) :
-			controlID(controlID),
-			smoothedValue(smoothedValue),
-			rampLengthInSeconds(rampLengthInSeconds)
-		{
-		}
-
-		ControlID controlID;
-		T smoothedValue;
-		double rampLengthInSeconds;
+		void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+		DirtyBitset<ControlID::countParams>* dirtyParameters{ nullptr };
+		int controlID{ 0 };
 	};
+	std::array<ParameterChangeListener, ControlID::countParams> parameterChangeListeners;
 
-	// -- (SmoothingType, idx) -> smoothingTypeArray[idx] = smoothedValue
-	std::array<SmoothingType, ControlID::countParams> smoothingTypes;
-	std::array<int, ControlID::countParams> smoothingValueIndexes;
-	// -- smoothed values
-	std::vector <SmoothedValue<juce::LinearSmoothedValue<float>>> linearSmoothedValues;
-	std::vector <SmoothedValue<juce::SmoothedValue<float, Multiplicative>>> multiplicativeSmoothedValues;
+	//==============================================================================
+	// -- State snapshots, inbound values of every parameter
+	// -- the message thread allocates and frees them, the audio thread only swaps pointers
+	struct ParameterSnapshot
+	{
+		std::array<float, ControlID::countParams> values;
+		double rampLengthInSeconds;
+	};
+	std::atomic<ParameterSnapshot*> pendingSnapshot{ nullptr }; // -- published, not adopted yet
+	std::atomic<ParameterSnapshot*> retiredSnapshot{ nullptr }; // -- adopted, waiting for the message thread to free it
+	ParameterSnapshot* adoptedSnapshot{ nullptr }; // -- audio thread only, until retiredSnapshot is free
 
 	// --- Parameters APVTS
 	const juce::String PARAMETERS_APVTS_ID = "ParametersAPVTS";
-	juce::AudioProcessorValueTreeState* apvts_ptr;
+	std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;
 
 	//==============================================================================
 	// -- PRIVATE METHODS
 	//==============================================================================
-	void updateSmoothingValue(ControlID controlID, float lastValue, float newValue);
+	void adoptParameterSnapshot();
+	void syncParameters(int numSamples, ParameterBits changedParameters, const std::array<float, ControlID::countParams>* inBoundValues);
+	void syncParameterGroups(ParameterBits& changedParameters, const std::array<float, ControlID::countParams>* inBoundValues);
+	float readInBoundVariable(int index, const std::array<float, ControlID::countParams>* inBoundValues);
+	void advanceSmoothedValues(int numSamples);
+	void updateCurrentValue(ControlID controlID);
 
 	//==============================================================================
-	template<typename T>
-	void addSmoothedValue(
-		ControlID controlID,
-		SmoothingType smoothingType,
-		T initialValue,
-		double rampLengthInSeconds
-	);
+	float safeMultiplicativeValue(float value, float smallestValue = 0.0001f);
 
 	//==============================================================================
-	float safeMultiplicativeValue(float value, float smallestValue = 0.0001f);
-	float safeDenormalizableValue(float value);
+	static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+	static std::unique_ptr<juce::RangedAudioParameter> createParameter(const ParameterDescriptor& descriptor);
 
 	//==============================================================================
-	juce::AudioProcessorValueTreeState::ParameterLayout initParamsAndCreateLayout();
+	JUCE_DECLARE_NON_COPYABLE(PluginStateManager)
 };
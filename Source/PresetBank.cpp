@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+	PresetBank.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+//==============================================================================
+PresetBank::PresetBank()
+{
+	addPreset("Init", getDefaultValues());
+}
+
+PresetBank::~PresetBank()
+{
+}
+
+//==============================================================================
+int PresetBank::getNumPresets() const
+{
+	return static_cast<int>(presets.size());
+}
+
+bool PresetBank::isValidIndex(int index) const
+{
+	return index >= 0 && index < getNumPresets();
+}
+
+const juce::String& PresetBank::getName(int index) const
+{
+	jassert(isValidIndex(index));
+	return presets[static_cast<size_t>(index)].name;
+}
+
+void PresetBank::setName(int index, const juce::String& newName)
+{
+	jassert(isValidIndex(index));
+	presets[static_cast<size_t>(index)].name = newName;
+}
+
+const PresetBank::Values& PresetBank::getValues(int index) const
+{
+	jassert(isValidIndex(index));
+	return presets[static_cast<size_t>(index)].values;
+}
+
+void PresetBank::setValues(int index, const Values& newValues)
+{
+	jassert(isValidIndex(index));
+	presets[static_cast<size_t>(index)].values = newValues;
+}
+
+int PresetBank::addPreset(const juce::String& name, const Values& values)
+{
+	presets.push_back({ name, values });
+	return getNumPresets() - 1;
+}
+
+void PresetBank::removePreset(int index)
+{
+	if (isValidIndex(index) && getNumPresets() > 1)
+	{
+		presets.erase(presets.begin() + index);
+	}
+}
+
+//==============================================================================
+PresetBank::Values PresetBank::getDefaultValues()
+{
+	Values values{};
+	for (int i{ 0 }; i < ControlID::countParams; ++i)
+	{
+		values[i] = ParameterDescriptors::table[i].defaultValue;
+	}
+	return values;
+}
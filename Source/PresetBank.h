@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+	PresetBank.h
+	In-memory presets, one plain value per ControlID
+
+	Backs the processor's programs. Recalling a preset hands its values to
+	PluginStateManager as one snapshot (restoreParameterValues), no XML or
+	ValueTree involved. Message thread only.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "parameterTypes.h"
+#include "ParameterDescriptors.h"
+
+//==============================================================================
+class PresetBank
+{
+public:
+	//==============================================================================
+	using Values = std::array<float, ControlID::countParams>;
+
+	//==============================================================================
+	// -- Starts with the default values as its first preset
+	PresetBank();
+	~PresetBank();
+
+	//==============================================================================
+	int getNumPresets() const;
+	bool isValidIndex(int index) const;
+
+	const juce::String& getName(int index) const;
+	void setName(int index, const juce::String& newName);
+
+	const Values& getValues(int index) const;
+	void setValues(int index, const Values& newValues);
+
+	// -- Returns the index of the new preset
+	int addPreset(const juce::String& name, const Values& values);
+	void removePreset(int index); // -- the last preset is never removed, hosts expect at least one program
+
+	//==============================================================================
+	static Values getDefaultValues();
+
+private:
+	//==============================================================================
+	struct Preset
+	{
+		juce::String name;
+		Values values;
+	};
+
+	std::vector<Preset> presets;
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(PresetBank)
+};
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+	SmootherBank.h
+	Structure-of-arrays pool of parameter smoothers of one SmoothingType
+
+	Same ramps as juce::LinearSmoothedValue / juce::SmoothedValue<float, Multiplicative>,
+	but values, steps and countdowns live in aligned arrays and advance(numSteps) moves
+	every smoother a whole block in one branch-free loop the compiler vectorises.
+	Smoothers that are not ramping go through the same loop and stay where they are, so
+	the cost per block depends on the pool size only. Multiplicative ramps keep their
+	per-block factor (step^numSteps) and recompute it only when the ramp or the block size
+	changes, so the loop has no libm call. fillBlock expands the last advance
+	into per-sample values for the consumers that want sample-accurate ramps.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "parameterTypes.h"
+
+//==============================================================================
+template <int numSmoothers, SmoothingType smoothingType>
+class SmootherBank
+{
+public:
+	static_assert(smoothingType != SmoothingType::NoSmoothing, "SmootherBank needs a Linear or Multiplicative SmoothingType");
+
+	//==============================================================================
+	SmootherBank()
+	{
+		// -- multiplicative ramps cannot start from 0
+		constexpr float initialValue = smoothingType == SmoothingType::Linear ? 0.f : 1.f;
+		currents.fill(initialValue);
+		targets.fill(initialValue);
+		steps.fill(0.f);
+		countdowns.fill(0);
+		blockStartValues.fill(initialValue);
+		blockStartCountdowns.fill(0);
+		blockMultipliers.fill(1.f);
+		blockMultiplierSteps.fill(0);
+		stepsToTarget.fill(0);
+		rampLengthsInSeconds.fill(0.0);
+	}
+
+	static constexpr int size()
+	{
+		return numSmoothers;
+	}
+
+	//==============================================================================
+	// -- Ramp length, reset(sampleRate) applies it
+	void setRampLength(int index, double rampLengthInSeconds)
+	{
+		rampLengthsInSeconds[index] = rampLengthInSeconds;
+	}
+
+	double getRampLength(int index) const
+	{
+		return rampLengthsInSeconds[index];
+	}
+
+	void reset(double sampleRate)
+	{
+		for (int i{ 0 }; i < numSmoothers; ++i)
+		{
+			reset(i, sampleRate, rampLengthsInSeconds[i]);
+		}
+	}
+
+	void reset(int index, double sampleRate, double rampLengthInSeconds)
+	{
+		rampLengthsInSeconds[index] = rampLengthInSeconds;
+		stepsToTarget[index] = sampleRate > 0.0 ? static_cast<int>(std::floor(rampLengthInSeconds * sampleRate)) : 0;
+		setCurrentAndTargetValue(index, targets[index]);
+	}
+
+	//==============================================================================
+	void setCurrentAndTargetValue(int index, float newValue)
+	{
+		currents[index] = newValue;
+		targets[index] = newValue;
+		countdowns[index] = 0;
+	}
+
+	// -- numSteps overrides the ramp length for this target only (preset morphs), negative keeps the smoother's own
+	void setTargetValue(int index, float newValue, int numSteps = -1)
+	{
+		if (newValue == targets[index])
+		{
+			return;
+		}
+
+		if (numSteps < 0)
+		{
+			numSteps = stepsToTarget[index];
+		}
+		if (numSteps <= 0)
+		{
+			setCurrentAndTargetValue(index, newValue);
+			return;
+		}
+
+		targets[index] = newValue;
+		countdowns[index] = numSteps;
+		if constexpr (smoothingType == SmoothingType::Linear)
+		{
+			steps[index] = (targets[index] - currents[index]) / static_cast<float>(countdowns[index]);
+		}
+		else
+		{
+			steps[index] = std::exp((std::log(std::abs(targets[index])) - std::log(std::abs(currents[index]))) / static_cast<float>(countdowns[index]));
+			blockMultiplierSteps[index] = 0; // -- new step, the block factor is stale
+		}
+	}
+
+	//==============================================================================
+	float getCurrentValue(int index) const
+	{
+		return currents[index];
+	}
+
+	float getTargetValue(int index) const
+	{
+		return targets[index];
+	}
+
+	bool isSmoothing(int index) const
+	{
+		return countdowns[index] > 0;
+	}
+
+	// -- Whether the smoother moved during the last advance(numSteps)
+	bool wasSmoothing(int index) const
+	{
+		return blockStartCountdowns[index] > 0;
+	}
+
+	// -- Steps a single smoother
+	float getNextValue(int index)
+	{
+		step(index);
+		return currents[index];
+	}
+
+	//==============================================================================
+	// -- Steps every smoother numSteps times (one block of numSteps samples)
+	void advance(int numSteps)
+	{
+		blockStartValues = currents;
+		blockStartCountdowns = countdowns;
+
+		if constexpr (smoothingType == SmoothingType::Multiplicative)
+		{
+			// -- pow only for ramps that go on past this block with a new step or block size, idle smoothers just compare
+			for (int i{ 0 }; i < numSmoothers; ++i)
+			{
+				if (countdowns[i] > numSteps && blockMultiplierSteps[i] != numSteps)
+				{
+					blockMultipliers[i] = std::pow(steps[i], static_cast<float>(numSteps));
+					blockMultiplierSteps[i] = numSteps;
+				}
+			}
+		}
+
+		for (int i{ 0 }; i < numSmoothers; ++i)
+		{
+			const int countdown = countdowns[i];
+			float stepped;
+			if constexpr (smoothingType == SmoothingType::Linear)
+			{
+				stepped = currents[i] + steps[i] * static_cast<float>(numSteps);
+			}
+			else
+			{
+				stepped = currents[i] * blockMultipliers[i]; // -- stale for smoothers that are not ramping, the select below drops it
+			}
+			currents[i] = countdown > numSteps ? stepped : (countdown > 0 ? targets[i] : currents[i]);
+			countdowns[i] = std::max(0, countdown - numSteps);
+		}
+	}
+
+	// -- Per-sample values of the last advance(numSteps) for one smoother, destination holds numSamples
+	void fillBlock(int index, float* destination, int numSamples) const
+	{
+		// -- the ramp reaches the target on its last step, countdown - 1 samples before that are in between
+		const int numRampSamples = std::clamp(blockStartCountdowns[index] - 1, 0, numSamples);
+		const float start = blockStartValues[index];
+		const float stepSize = steps[index];
+
+		if constexpr (smoothingType == SmoothingType::Linear)
+		{
+			for (int i{ 0 }; i < numRampSamples; ++i)
+			{
+				destination[i] = start + stepSize * static_cast<float>(i + 1);
+			}
+		}
+		else
+		{
+			float value = start;
+			for (int i{ 0 }; i < numRampSamples; ++i)
+			{
+				value *= stepSize;
+				destination[i] = value;
+			}
+		}
+		std::fill(destination + numRampSamples, destination + numSamples, targets[index]);
+	}
+
+private:
+	//==============================================================================
+	alignas(16) std::array<float, numSmoothers> currents;
+	alignas(16) std::array<float, numSmoothers> targets;
+	alignas(16) std::array<float, numSmoothers> steps;
+	alignas(16) std::array<int, numSmoothers> countdowns;
+	// -- state before the last advance(numSteps), fillBlock starts from here
+	alignas(16) std::array<float, numSmoothers> blockStartValues;
+	alignas(16) std::array<int, numSmoothers> blockStartCountdowns;
+	// -- Multiplicative only: steps[i]^blockMultiplierSteps[i], 0 steps when it needs recomputing
+	alignas(16) std::array<float, numSmoothers> blockMultipliers;
+	std::array<int, numSmoothers> blockMultiplierSteps;
+	// -- only read when a target or the sample rate changes
+	std::array<int, numSmoothers> stepsToTarget;
+	std::array<double, numSmoothers> rampLengthsInSeconds;
+
+	//==============================================================================
+	// -- Single step, the last step lands exactly on the target
+	inline void step(int index)
+	{
+		const int countdown = countdowns[index];
+		float stepped;
+		if constexpr (smoothingType == SmoothingType::Linear)
+		{
+			stepped = currents[index] + steps[index];
+		}
+		else
+		{
+			stepped = currents[index] * steps[index];
+		}
+		currents[index] = countdown > 1 ? stepped : (countdown == 1 ? targets[index] : currents[index]);
+		countdowns[index] = countdown > 0 ? countdown - 1 : 0;
+	}
+};
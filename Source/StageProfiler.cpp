@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+	StageProfiler.cpp
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+#if TALKINGHEADS_STAGE_PROFILING
+
+#include <algorithm>
+
+#if JUCE_INTEL
+#if JUCE_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+//==============================================================================
+StageProfiler::StageProfiler()
+{
+	for (auto& stageHistory : history)
+	{
+		stageHistory.resize(historySize, 0);
+	}
+	scratch.reserve(historySize);
+}
+
+StageProfiler::~StageProfiler()
+{
+}
+
+//==============================================================================
+// -- Audio thread
+void StageProfiler::beginBlock(int numSamples)
+{
+	currentRecord.numSamples = numSamples;
+	currentRecord.startTicks = juce::Time::getHighResolutionTicks();
+	currentRecord.startCycles = readTimestamp();
+	currentRecord.stageCycles.fill(0);
+}
+
+void StageProfiler::endBlock()
+{
+	const auto scope = fifo.write(1);
+	if (scope.blockSize1 + scope.blockSize2 == 0)
+	{
+		numDroppedBlocks.fetch_add(1, std::memory_order_relaxed); // -- nobody is draining, drop rather than wait
+		return;
+	}
+	records[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = currentRecord;
+}
+
+void StageProfiler::addStageTime(ProfiledStage stage, juce::int64 elapsedCycles)
+{
+	currentRecord.stageCycles[enumToInt(stage)] += elapsedCycles;
+}
+
+juce::int64 StageProfiler::readTimestamp()
+{
+#if JUCE_INTEL
+	return static_cast<juce::int64>(__rdtsc());
+#else
+	return juce::Time::getHighResolutionTicks();
+#endif
+}
+
+//==============================================================================
+// -- Consumer thread
+StageProfiler::Statistics StageProfiler::drain()
+{
+	const auto scope = fifo.read(fifo.getNumReady());
+	auto consume = [this](int start, int size)
+		{
+			for (int i{ start }; i < start + size; ++i)
+			{
+				calibrate(records[i]);
+				for (int stage{ 0 }; stage < numStages; ++stage)
+				{
+					history[stage][historyPosition] = records[i].stageCycles[stage];
+				}
+				historyPosition = (historyPosition + 1) % historySize;
+				historyCount = std::min(historyCount + 1, historySize);
+			}
+		};
+	consume(scope.startIndex1, scope.blockSize1);
+	consume(scope.startIndex2, scope.blockSize2);
+
+	Statistics statistics;
+	if (historyCount == 0 || nanosecondsPerCycle <= 0.0)
+	{
+		return statistics;
+	}
+
+	for (int stage{ 0 }; stage < numStages; ++stage)
+	{
+		scratch.assign(history[stage].begin(), history[stage].begin() + historyCount);
+
+		juce::int64 total = 0;
+		for (auto cycles : scratch)
+		{
+			total += cycles;
+		}
+
+		const auto p99Index = static_cast<size_t>(0.99 * static_cast<double>(historyCount - 1));
+		std::nth_element(scratch.begin(), scratch.begin() + p99Index, scratch.end());
+
+		auto& stageStatistics = statistics[stage];
+		stageStatistics.count = historyCount;
+		stageStatistics.p99Ns = static_cast<double>(scratch[p99Index]) * nanosecondsPerCycle;
+		stageStatistics.minNs = static_cast<double>(*std::min_element(scratch.begin(), scratch.end())) * nanosecondsPerCycle;
+		stageStatistics.meanNs = static_cast<double>(total) / static_cast<double>(historyCount) * nanosecondsPerCycle;
+	}
+
+	return statistics;
+}
+
+int StageProfiler::getNumDroppedBlocks() const
+{
+	return numDroppedBlocks.load(std::memory_order_relaxed);
+}
+
+const char* StageProfiler::getStageName(ProfiledStage stage)
+{
+	switch (stage)
+	{
+	case ProfiledStage::preProcessBlock:
+		return "preProcessBlock";
+	case ProfiledStage::preGain:
+		return "preGain";
+	case ProfiledStage::multiBandEQ:
+		return "multiBandEQ";
+	case ProfiledStage::multiBandCompressor:
+		return "multiBandCompressor";
+	case ProfiledStage::imager:
+		return "imager";
+	case ProfiledStage::phaser:
+		return "phaser";
+	case ProfiledStage::blendMixer:
+		return "blendMixer";
+	case ProfiledStage::countStages:
+		break;
+	}
+	return "";
+}
+
+//==============================================================================
+void StageProfiler::calibrate(const BlockRecord& record)
+{
+	if (!isCalibrated)
+	{
+		firstRecord = record;
+		isCalibrated = true;
+		return;
+	}
+
+	// -- Cycle counter rate measured against the high resolution clock since the first record
+	const auto elapsedCycles = record.startCycles - firstRecord.startCycles;
+	const auto elapsedTicks = record.startTicks - firstRecord.startTicks;
+	if (elapsedCycles > 0 && elapsedTicks > 0)
+	{
+		const double nanosecondsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+		nanosecondsPerCycle = static_cast<double>(elapsedTicks) * nanosecondsPerTick / static_cast<double>(elapsedCycles);
+	}
+}
+
+#endif
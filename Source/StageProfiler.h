@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+	StageProfiler.h
+	Per-stage timing of processBlock
+
+	The audio thread timestamps each stage of a block and pushes one record per block
+	into a lock-free single producer / single consumer FIFO. A background or editor thread
+	drains it and keeps min/mean/p99 per stage over the most recent blocks.
+
+	Only compiled in with TALKINGHEADS_STAGE_PROFILING=1, otherwise the STAGE_PROFILER_*
+	macros expand to nothing and the processor holds no profiler.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TALKINGHEADS_STAGE_PROFILING
+#define TALKINGHEADS_STAGE_PROFILING 0
+#endif
+
+#if TALKINGHEADS_STAGE_PROFILING
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "parameterTypes.h"
+
+//==============================================================================
+enum class ProfiledStage
+{
+	preProcessBlock,
+	preGain,
+	multiBandEQ,
+	multiBandCompressor,
+	imager,
+	phaser,
+	blendMixer,
+	//==============================================================================
+	countStages
+};
+
+//==============================================================================
+class StageProfiler
+{
+public:
+	//==============================================================================
+	static constexpr int numStages{ enumToInt(ProfiledStage::countStages) };
+	static constexpr int fifoSize{ 1024 };
+	static constexpr int historySize{ 4096 };
+
+	struct StageStatistics
+	{
+		int count{ 0 };
+		double minNs{ 0.0 };
+		double meanNs{ 0.0 };
+		double p99Ns{ 0.0 };
+	};
+
+	using Statistics = std::array<StageStatistics, numStages>;
+
+	//==============================================================================
+	StageProfiler();
+	~StageProfiler();
+
+	//==============================================================================
+	// -- Audio thread
+	void beginBlock(int numSamples);
+	void endBlock();
+	void addStageTime(ProfiledStage stage, juce::int64 elapsedCycles);
+
+	static juce::int64 readTimestamp();
+
+	class ScopedBlock
+	{
+	public:
+		ScopedBlock(StageProfiler& profiler, int numSamples) : profiler(profiler) { profiler.beginBlock(numSamples); }
+		~ScopedBlock() { profiler.endBlock(); }
+
+	private:
+		StageProfiler& profiler;
+	};
+
+	class ScopedStageTimer
+	{
+	public:
+		ScopedStageTimer(StageProfiler& profiler, ProfiledStage stage) : profiler(profiler), stage(stage), start(readTimestamp()) {}
+		~ScopedStageTimer() { profiler.addStageTime(stage, readTimestamp() - start); }
+
+	private:
+		StageProfiler& profiler;
+		ProfiledStage stage;
+		juce::int64 start;
+	};
+
+	//==============================================================================
+	// -- Consumer thread
+	// -- Pops every pending record into the history and returns the statistics over it
+	Statistics drain();
+	int getNumDroppedBlocks() const;
+
+	static const char* getStageName(ProfiledStage stage);
+
+private:
+	//==============================================================================
+	struct BlockRecord
+	{
+		int numSamples{ 0 };
+		juce::int64 startCycles{ 0 };
+		juce::int64 startTicks{ 0 }; // -- high resolution ticks, to calibrate cycles to time
+		std::array<juce::int64, numStages> stageCycles{};
+	};
+
+	// -- Audio thread
+	BlockRecord currentRecord;
+	juce::AbstractFifo fifo{ fifoSize };
+	std::array<BlockRecord, fifoSize> records;
+	std::atomic<int> numDroppedBlocks{ 0 };
+
+	// -- Consumer thread
+	bool isCalibrated{ false };
+	BlockRecord firstRecord;
+	double nanosecondsPerCycle{ 0.0 };
+	std::array<std::vector<juce::int64>, numStages> history;
+	int historyPosition{ 0 };
+	int historyCount{ 0 };
+	std::vector<juce::int64> scratch;
+
+	//==============================================================================
+	void calibrate(const BlockRecord& record);
+};
+
+//==============================================================================
+#define STAGE_PROFILER_BLOCK(profiler, numSamples) const StageProfiler::ScopedBlock stageProfilerBlock(profiler, numSamples)
+#define STAGE_PROFILER_SCOPE(profiler, stage) const StageProfiler::ScopedStageTimer JUCE_JOIN_MACRO(stageProfilerScope_, __LINE__)(profiler, stage)
+
+#else
+
+#define STAGE_PROFILER_BLOCK(profiler, numSamples)
+#define STAGE_PROFILER_SCOPE(profiler, stage)
+
+#endif
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+	TelemetryChannel.cpp
+
+  ==============================================================================
+*/
+
+#include <cmath>
+#include "TelemetryChannel.h"
+
+//==============================================================================
+TelemetryChannel::TelemetryChannel()
+{
+}
+
+TelemetryChannel::~TelemetryChannel()
+{
+}
+
+//==============================================================================
+// -- Audio thread
+void TelemetryChannel::beginBlock(int numSamples)
+{
+	// -- The consumer only frees space, so a slot seen here is still there in endBlock
+	publishing = fifo.getFreeSpace() > 0;
+	if (!publishing)
+	{
+		numDroppedBlocks.fetch_add(1, std::memory_order_relaxed); // -- nobody is draining, drop rather than wait
+		return;
+	}
+
+	currentRecord = BlockRecord();
+	currentRecord.numSamples = numSamples;
+}
+
+void TelemetryChannel::setStageLevels(TelemetryStage stage, const juce::dsp::AudioBlock<const float>& block)
+{
+	if (!publishing)
+	{
+		return;
+	}
+	currentRecord.levels[enumToInt(stage)] = measureLevels(block);
+}
+
+void TelemetryChannel::setGainReduction(int band, float gainReductionDecibels)
+{
+	jassert(band >= 0 && band < numCompressorBands);
+	if (!publishing)
+	{
+		return;
+	}
+	currentRecord.gainReductionDecibels[band] = gainReductionDecibels;
+}
+
+void TelemetryChannel::setImagerWidth(float width)
+{
+	if (!publishing)
+	{
+		return;
+	}
+	currentRecord.imagerWidth = width;
+}
+
+void TelemetryChannel::endBlock()
+{
+	if (!publishing)
+	{
+		return;
+	}
+
+	const auto scope = fifo.write(1);
+	jassert(scope.blockSize1 + scope.blockSize2 == 1);
+	records[scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2] = currentRecord;
+}
+
+bool TelemetryChannel::isPublishing() const
+{
+	return publishing;
+}
+
+TelemetryChannel::Levels TelemetryChannel::measureLevels(const juce::dsp::AudioBlock<const float>& block)
+{
+	const auto numChannels = block.getNumChannels();
+	const auto numSamples = block.getNumSamples();
+
+	Levels levels;
+	if (numChannels == 0 || numSamples == 0)
+	{
+		return levels;
+	}
+
+	// -- peak and RMS over every channel
+	double sumOfSquares{ 0.0 };
+	for (size_t channel{ 0 }; channel < numChannels; ++channel)
+	{
+		const float* samples = block.getChannelPointer(channel);
+		auto range = juce::FloatVectorOperations::findMinAndMax(samples, static_cast<int>(numSamples));
+		levels.peak = juce::jmax(levels.peak, -range.getStart(), range.getEnd());
+		for (size_t i{ 0 }; i < numSamples; ++i)
+		{
+			sumOfSquares += static_cast<double>(samples[i]) * samples[i];
+		}
+	}
+	levels.rms = static_cast<float>(std::sqrt(sumOfSquares / static_cast<double>(numChannels * numSamples)));
+	return levels;
+}
+
+//==============================================================================
+// -- Message thread
+void TelemetryChannel::attach()
+{
+	// -- Reading without looking is the consumer's reset, fifo.reset() would race the audio thread
+	const auto scope = fifo.read(fifo.getNumReady());
+	juce::ignoreUnused(scope);
+}
+
+TelemetryChannel::Frame TelemetryChannel::drain()
+{
+	Frame frame;
+	std::array<double, numStages> sumsOfSquares{};
+
+	const auto scope = fifo.read(fifo.getNumReady());
+	auto consume = [this, &frame, &sumsOfSquares](int start, int size)
+		{
+			for (int i{ start }; i < start + size; ++i)
+			{
+				const auto& record = records[i];
+				for (int stage{ 0 }; stage < numStages; ++stage)
+				{
+					frame.levels[stage].peak = juce::jmax(frame.levels[stage].peak, record.levels[stage].peak);
+					sumsOfSquares[stage] += static_cast<double>(record.levels[stage].rms) * record.levels[stage].rms * record.numSamples;
+				}
+				for (int band{ 0 }; band < numCompressorBands; ++band)
+				{
+					frame.gainReductionDecibels[band] = juce::jmax(frame.gainReductionDecibels[band], record.gainReductionDecibels[band]);
+				}
+				frame.imagerWidth = record.imagerWidth;
+				frame.numSamples += record.numSamples;
+				++frame.numBlocks;
+			}
+		};
+	consume(scope.startIndex1, scope.blockSize1);
+	consume(scope.startIndex2, scope.blockSize2);
+
+	if (frame.numSamples > 0)
+	{
+		for (int stage{ 0 }; stage < numStages; ++stage)
+		{
+			frame.levels[stage].rms = static_cast<float>(std::sqrt(sumsOfSquares[stage] / frame.numSamples));
+		}
+	}
+	return frame;
+}
+
+int TelemetryChannel::getNumDroppedBlocks() const
+{
+	return numDroppedBlocks.load(std::memory_order_relaxed);
+}
+
+const char* TelemetryChannel::getStageName(TelemetryStage stage)
+{
+	switch (stage)
+	{
+	case TelemetryStage::input:
+		return "input";
+	case TelemetryStage::preGain:
+		return "preGain";
+	case TelemetryStage::multiBandEQ:
+		return "multiBandEQ";
+	case TelemetryStage::multiBandCompressor:
+		return "multiBandCompressor";
+	case TelemetryStage::imager:
+		return "imager";
+	case TelemetryStage::phaser:
+		return "phaser";
+	case TelemetryStage::output:
+		return "output";
+	default:
+		return "";
+	}
+}
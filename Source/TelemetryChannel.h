@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+	TelemetryChannel.h
+	Audio thread to UI telemetry: levels per stage, compressor gain reduction, imager width
+
+	The audio thread fills one fixed-size record per block and pushes it into a lock-free
+	single producer / single consumer FIFO. When the FIFO is full (no editor draining) the
+	block is dropped up front, in beginBlock, so nothing is measured for it. The message
+	thread drains at display rate and gets every record since the last drain coalesced into
+	one frame: peaks and gain reductions keep their maximum, RMS levels are averaged over
+	the samples, the imager width is the latest. A reader that starts draining calls attach
+	first, so it does not show the blocks left over from before it was there.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "parameterTypes.h"
+
+//==============================================================================
+enum class TelemetryStage
+{
+	input,
+	preGain,
+	multiBandEQ,
+	multiBandCompressor,
+	imager,
+	phaser,
+	output,
+	//==============================================================================
+	countStages
+};
+
+//==============================================================================
+class TelemetryChannel
+{
+public:
+	//==============================================================================
+	static constexpr int numStages{ enumToInt(TelemetryStage::countStages) };
+	static constexpr int numCompressorBands{ 3 };
+	static constexpr int fifoSize{ 256 };
+
+	struct Levels
+	{
+		float peak{ 0.f };
+		float rms{ 0.f };
+	};
+
+	// -- Every record drained at once, numBlocks is 0 when nothing new was published
+	struct Frame
+	{
+		int numBlocks{ 0 };
+		int numSamples{ 0 };
+		std::array<Levels, numStages> levels{};
+		std::array<float, numCompressorBands> gainReductionDecibels{};
+		float imagerWidth{ 0.f };
+	};
+
+	//==============================================================================
+	TelemetryChannel();
+	~TelemetryChannel();
+
+	//==============================================================================
+	// -- Audio thread -- stages left unset for a block (bypassed) report silence
+	void beginBlock(int numSamples);
+	void setStageLevels(TelemetryStage stage, const juce::dsp::AudioBlock<const float>& block);
+	void setGainReduction(int band, float gainReductionDecibels);
+	void setImagerWidth(float width);
+	void endBlock();
+	bool isPublishing() const; // -- false between beginBlock and endBlock of a dropped block, skip measuring for it
+
+	static Levels measureLevels(const juce::dsp::AudioBlock<const float>& block);
+
+	//==============================================================================
+	// -- Message thread
+	void attach(); // -- discards whatever is queued, the consumer side of the FIFO is ours
+	Frame drain();
+	int getNumDroppedBlocks() const;
+
+	static const char* getStageName(TelemetryStage stage);
+
+private:
+	//==============================================================================
+	struct BlockRecord
+	{
+		int numSamples{ 0 };
+		std::array<Levels, numStages> levels{};
+		std::array<float, numCompressorBands> gainReductionDecibels{};
+		float imagerWidth{ 0.f };
+	};
+
+	// -- Audio thread
+	BlockRecord currentRecord;
+	bool publishing{ false }; // -- false for a block the FIFO has no room for
+	juce::AbstractFifo fifo{ fifoSize };
+	std::array<BlockRecord, fifoSize> records;
+	std::atomic<int> numDroppedBlocks{ 0 };
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE(TelemetryChannel)
+};
@@ -18,6 +18,14 @@
 #define compareEnumToInt(ENUM, INT) (enumToInt(ENUM) == INT)
 #define compareIntToEnum(INT, ENUM) (INT == enumToInt(ENUM))
 
+enum class ParameterType
+{
+	Bool,
+	Choice,
+	Float,
+	Int
+};
+
 enum class SmoothingType
 {
 	NoSmoothing,
@@ -118,4 +126,19 @@ enum ControlID
 
 	//==============================================================================
 	countParams // value to keep track of the total number of parameters
+};
+
+//==============================================================================
+// --- PARAMETER GROUP IDs -- one per stage, same blocks as the ControlIDs above
+//==============================================================================
+enum ParameterGroupID
+{
+	generalGroup,
+	equalizerGroup,
+	compressorGroup,
+	imagerGroup,
+	phaserGroup,
+
+	//==============================================================================
+	countGroups // value to keep track of the total number of groups
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+	InstantiationBenchmark.cpp
+	Instantiate-to-first-block latency of TalkingHeadsPluginAudioProcessor
+
+	usage: talkingheads_bench_instantiation [--iterations 200] [--sample-rate 48000] [--block-size 512]
+		[--output results.json]
+
+	Times the three steps a host goes through when scanning or loading a session: construction,
+	prepareToPlay and the first processBlock, and counts the operator new calls each one makes.
+	The first instance is reported on its own (cold: static initialisation, first touch of the code),
+	the remaining iterations as p50/p99.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "PluginProcessor.h"
+#include "ToolUtilities.h"
+
+//==============================================================================
+// -- Allocation counting, the replaced operators are global to this executable
+namespace
+{
+	std::atomic<juce::int64> numAllocations{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+	numAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	//==============================================================================
+	enum Phase
+	{
+		construct,
+		prepare,
+		firstBlock,
+		total,
+		//==============================================================================
+		countPhases
+	};
+
+	const char* phaseNames[countPhases]{ "construct", "prepareToPlay", "first processBlock", "total" };
+
+	struct Measurement
+	{
+		std::array<double, countPhases> ns{};
+		std::array<juce::int64, countPhases> allocations{};
+	};
+
+	//==============================================================================
+	Measurement instantiate(double sampleRate, int blockSize)
+	{
+		Measurement measurement;
+		juce::AudioBuffer<float> buffer(2, blockSize);
+		buffer.clear();
+		juce::MidiBuffer midi;
+
+		auto timePhase = [&measurement](Phase phase, auto&& function)
+			{
+				const auto allocationsBefore = numAllocations.load(std::memory_order_relaxed);
+				const auto start = juce::Time::getHighResolutionTicks();
+				function();
+				measurement.ns[phase] = ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start);
+				measurement.allocations[phase] = numAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+			};
+
+		std::unique_ptr<TalkingHeadsPluginAudioProcessor> processor;
+		timePhase(Phase::construct, [&] { processor = std::make_unique<TalkingHeadsPluginAudioProcessor>(); });
+		timePhase(Phase::prepare, [&] { ToolUtilities::prepareProcessor(*processor, sampleRate, blockSize); });
+		timePhase(Phase::firstBlock, [&] { processor->processBlock(buffer, midi); });
+
+		for (int phase{ 0 }; phase < Phase::total; ++phase)
+		{
+			measurement.ns[Phase::total] += measurement.ns[phase];
+			measurement.allocations[Phase::total] += measurement.allocations[phase];
+		}
+		return measurement;
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	const int iterations = juce::jmax(2, ToolUtilities::getIntOption(args, "--iterations", 200));
+	const double sampleRate = ToolUtilities::getDoubleOption(args, "--sample-rate", 48000.0);
+	const int blockSize = ToolUtilities::getIntOption(args, "--block-size", 512);
+
+	const auto cold = instantiate(sampleRate, blockSize);
+
+	std::array<std::vector<double>, countPhases> warmNs;
+	std::array<juce::int64, countPhases> warmAllocations{};
+	for (int i{ 1 }; i < iterations; ++i)
+	{
+		const auto measurement = instantiate(sampleRate, blockSize);
+		for (int phase{ 0 }; phase < countPhases; ++phase)
+		{
+			warmNs[phase].push_back(measurement.ns[phase]);
+			warmAllocations[phase] = measurement.allocations[phase];
+		}
+	}
+
+	//==============================================================================
+	std::cout << juce::String("phase").paddedRight(' ', 20) << juce::String("cold us").paddedLeft(' ', 12) << juce::String("p50 us").paddedLeft(' ', 12)
+		<< juce::String("p99 us").paddedLeft(' ', 12) << juce::String("allocations").paddedLeft(' ', 14) << std::endl;
+
+	juce::Array<juce::var> phases;
+	for (int phase{ 0 }; phase < countPhases; ++phase)
+	{
+		auto summary = ToolUtilities::summarise(warmNs[phase]);
+		std::cout << juce::String(phaseNames[phase]).paddedRight(' ', 20)
+			<< juce::String(cold.ns[phase] * 1.0e-3, 1).paddedLeft(' ', 12)
+			<< juce::String(summary.p50Ns * 1.0e-3, 1).paddedLeft(' ', 12)
+			<< juce::String(summary.p99Ns * 1.0e-3, 1).paddedLeft(' ', 12)
+			<< juce::String(warmAllocations[phase]).paddedLeft(' ', 14) << std::endl;
+
+		auto* object = new juce::DynamicObject();
+		object->setProperty("phase", phaseNames[phase]);
+		object->setProperty("coldNs", cold.ns[phase]);
+		object->setProperty("coldAllocations", cold.allocations[phase]);
+		object->setProperty("warm", ToolUtilities::timingSummaryToVar(summary));
+		object->setProperty("allocations", warmAllocations[phase]);
+		phases.add(juce::var(object));
+	}
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "instantiation");
+		report->setProperty("sampleRate", sampleRate);
+		report->setProperty("blockSize", blockSize);
+		report->setProperty("phases", phases);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+	MemoryBenchmark.cpp
+	Per-instance memory of TalkingHeadsPluginAudioProcessor, by component
+
+	usage: talkingheads_bench_memory [--sample-rates 44100,48000,96000,192000] [--block-size 512]
+		[--instances 16] [--output results.json]
+
+	For each sample rate, prints the bytes each component reports through getMemoryFootprint
+	after prepareToPlay. With glibc it also measures the heap growth of constructing and preparing
+	--instances processors, so what the components do not account for (APVTS, juce internals,
+	allocator overhead) shows up as the difference.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "PluginProcessor.h"
+#include "ToolUtilities.h"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define TALKINGHEADS_HAS_MALLINFO2 1
+#else
+#define TALKINGHEADS_HAS_MALLINFO2 0
+#endif
+
+namespace
+{
+	//==============================================================================
+	// -- Bytes currently allocated on the heap, -1 if unknown
+	juce::int64 getHeapBytes()
+	{
+#if TALKINGHEADS_HAS_MALLINFO2
+		auto info = mallinfo2();
+		return static_cast<juce::int64>(info.uordblks + info.hblkhd);
+#else
+		return -1;
+#endif
+	}
+
+	//==============================================================================
+	juce::var runSampleRate(double sampleRate, int blockSize, int numInstances)
+	{
+		std::vector<std::unique_ptr<TalkingHeadsPluginAudioProcessor>> processors;
+		processors.reserve(static_cast<size_t>(numInstances));
+
+		const auto heapBefore = getHeapBytes();
+		for (int i{ 0 }; i < numInstances; ++i)
+		{
+			processors.push_back(std::make_unique<TalkingHeadsPluginAudioProcessor>());
+			ToolUtilities::prepareProcessor(*processors.back(), sampleRate, blockSize);
+		}
+
+		const auto heapAfter = getHeapBytes();
+		const double measuredBytes = heapBefore >= 0 ? static_cast<double>(heapAfter - heapBefore) / numInstances : -1.0;
+
+		//==============================================================================
+		auto footprint = processors.front()->getMemoryFootprint();
+		const auto reportedBytes = footprint.getTotalBytes();
+
+		std::cout << "sample rate " << sampleRate << " Hz, block size " << blockSize << std::endl;
+
+		juce::Array<juce::var> components;
+		for (const auto& component : footprint.getComponents())
+		{
+			std::cout << "  " << component.name.paddedRight(' ', 48) << juce::String(static_cast<juce::int64>(component.bytes)).paddedLeft(' ', 10) << " B" << std::endl;
+
+			auto* object = new juce::DynamicObject();
+			object->setProperty("name", component.name);
+			object->setProperty("bytes", static_cast<juce::int64>(component.bytes));
+			components.add(juce::var(object));
+		}
+
+		std::cout << "  " << juce::String("reported total").paddedRight(' ', 48) << juce::String(static_cast<juce::int64>(reportedBytes)).paddedLeft(' ', 10) << " B" << std::endl;
+		if (measuredBytes >= 0.0)
+		{
+			std::cout << "  " << juce::String("measured heap per instance").paddedRight(' ', 48) << juce::String(juce::roundToInt(measuredBytes)).paddedLeft(' ', 10) << " B"
+				<< " (" << juce::roundToInt(measuredBytes - static_cast<double>(reportedBytes)) << " B not reported)" << std::endl;
+		}
+
+		auto* result = new juce::DynamicObject();
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("components", components);
+		result->setProperty("reportedBytes", static_cast<juce::int64>(reportedBytes));
+		result->setProperty("measuredHeapBytesPerInstance", measuredBytes >= 0.0 ? juce::var(measuredBytes) : juce::var());
+		return juce::var(result);
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	std::vector<double> sampleRates;
+	for (auto& token : juce::StringArray::fromTokens(ToolUtilities::getStringOption(args, "--sample-rates", "44100,48000,96000,192000"), ",", ""))
+	{
+		sampleRates.push_back(token.getDoubleValue());
+	}
+	const int blockSize = ToolUtilities::getIntOption(args, "--block-size", 512);
+	const int numInstances = juce::jmax(1, ToolUtilities::getIntOption(args, "--instances", 16));
+
+	if (getHeapBytes() < 0)
+	{
+		std::cout << "heap measurement unavailable (needs glibc 2.33), reporting components only" << std::endl;
+	}
+
+	juce::Array<juce::var> results;
+	for (auto sampleRate : sampleRates)
+	{
+		results.add(runSampleRate(sampleRate, blockSize, numInstances));
+	}
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "memory");
+		report->setProperty("results", results);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return 0;
+}
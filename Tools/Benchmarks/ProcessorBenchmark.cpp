@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+	ProcessorBenchmark.cpp
+	Microbenchmarks for each juce::dsp::ProcessorBase stage driven in isolation through prepare/process
+
+	usage: talkingheads_bench_processors [--output results.json] [--baseline baseline.json] [--update-baseline]
+		[--tolerance 0.1] [--processor EQBand] [--block-sizes 16,64,512] [--sample-rates 48000] [--seconds 0.5]
+		[--implementation reference|optimised]
+
+	Sweeps block size, sample rate and parameter state (bypassed, static, automated every block).
+	--baseline writes the results to the given file if it does not exist yet, otherwise compares
+	against it and returns 1 if any case is slower than the tolerance allows. The implementation
+	is not part of the result key, so a reference baseline can be compared against optimised runs.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <map>
+#include "StageCases.h"
+#include "StateHostProcessor.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	enum class ParameterState
+	{
+		Bypassed,
+		Static,
+		Automated
+	};
+
+	juce::String toString(ParameterState state)
+	{
+		switch (state)
+		{
+		case ParameterState::Bypassed:
+			return "bypassed";
+		case ParameterState::Static:
+			return "static";
+		case ParameterState::Automated:
+			return "automated";
+		}
+		return {};
+	}
+
+	//==============================================================================
+	struct BenchmarkConfig
+	{
+		double sampleRate;
+		int blockSize;
+		ParameterState state;
+		double seconds;
+		DSPImplementation implementation;
+	};
+
+	juce::var runCase(const ToolUtilities::StageCase& stageCase, const BenchmarkConfig& config)
+	{
+		StateHostProcessor host;
+		auto stateManager = host.getStateManager();
+
+		// -- Parameter state before prepare, smoothing snapped to it
+		for (auto bypassID : stageCase.bypassIDs)
+		{
+			host.setParameterValue(bypassID, config.state == ParameterState::Bypassed ? 1.f : 0.f);
+		}
+		stateManager->syncInBoundVariables(config.blockSize);
+		stateManager->initSmoothedValues(config.sampleRate, config.blockSize);
+
+		auto processor = stageCase.create(stateManager, config.implementation);
+		juce::dsp::ProcessSpec spec{ config.sampleRate, static_cast<juce::uint32>(config.blockSize), static_cast<juce::uint32>(stageCase.numChannels) };
+		processor->prepare(spec);
+
+		juce::AudioBuffer<float> buffer(stageCase.numChannels, config.blockSize);
+		juce::Random random(0x7a1c);
+
+		const int warmupBlocks = 16;
+		const int timedBlocks = juce::jmax(64, juce::roundToInt(config.seconds * config.sampleRate / config.blockSize));
+		std::vector<double> blockNs;
+		blockNs.reserve(static_cast<size_t>(timedBlocks));
+
+		for (int block{ 0 }; block < warmupBlocks + timedBlocks; ++block)
+		{
+			// -- Automation: move every non-bypass parameter of the stage each block
+			if (config.state == ParameterState::Automated)
+			{
+				const float phase = static_cast<float>(block) * 0.05f;
+				for (size_t i{ 0 }; i < stageCase.automatedIDs.size(); ++i)
+				{
+					host.setParameterNormalisedValue(stageCase.automatedIDs[i], 0.5f + 0.45f * std::sin(phase + static_cast<float>(i)));
+				}
+			}
+			stateManager->syncInBoundVariables(config.blockSize);
+
+			// -- Mono input in channel 0, the rest cleared
+			buffer.clear();
+			auto* samples = buffer.getWritePointer(0);
+			for (int i{ 0 }; i < config.blockSize; ++i)
+			{
+				samples[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+			}
+
+			juce::dsp::AudioBlock<float> audioBlock(buffer);
+			juce::dsp::ProcessContextReplacing<float> context(audioBlock);
+
+			const auto start = juce::Time::getHighResolutionTicks();
+			processor->process(context);
+			const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+			if (block >= warmupBlocks)
+			{
+				blockNs.push_back(ToolUtilities::ticksToNanoseconds(elapsed));
+			}
+		}
+
+		auto summary = ToolUtilities::summarise(blockNs);
+
+		auto* result = new juce::DynamicObject();
+		result->setProperty("processor", stageCase.name);
+		result->setProperty("sampleRate", config.sampleRate);
+		result->setProperty("blockSize", config.blockSize);
+		result->setProperty("state", toString(config.state));
+		result->setProperty("implementation", config.implementation == DSPImplementation::Optimised && stageCase.hasOptimised ? "optimised" : "reference");
+		result->setProperty("nsPerSample", summary.meanNs / config.blockSize);
+		result->setProperty("block", ToolUtilities::timingSummaryToVar(summary));
+		return juce::var(result);
+	}
+
+	//==============================================================================
+	juce::String getResultKey(const juce::var& result)
+	{
+		return result["processor"].toString()
+			+ "|" + juce::String(static_cast<double>(result["sampleRate"]))
+			+ "|" + juce::String(static_cast<int>(result["blockSize"]))
+			+ "|" + result["state"].toString();
+	}
+
+	// -- Returns the number of regressions
+	int compareWithBaseline(const juce::var& results, const juce::var& baseline, double tolerance)
+	{
+		std::map<juce::String, double> baselineNsPerSample;
+		if (auto* baselineResults = baseline["results"].getArray())
+		{
+			for (auto& result : *baselineResults)
+			{
+				baselineNsPerSample[getResultKey(result)] = result["nsPerSample"];
+			}
+		}
+
+		int regressions = 0;
+		for (auto& result : *results["results"].getArray())
+		{
+			auto key = getResultKey(result);
+			auto found = baselineNsPerSample.find(key);
+			if (found == baselineNsPerSample.end() || found->second <= 0.0)
+			{
+				std::cout << key << ": no baseline" << std::endl;
+				continue;
+			}
+
+			const double ratio = static_cast<double>(result["nsPerSample"]) / found->second;
+			const bool regressed = ratio > 1.0 + tolerance;
+			regressions += regressed ? 1 : 0;
+			std::cout << key << ": " << found->second << " -> " << static_cast<double>(result["nsPerSample"])
+				<< " ns/sample (x" << ratio << ")" << (regressed ? "  REGRESSION" : "") << std::endl;
+		}
+
+		return regressions;
+	}
+
+	//==============================================================================
+	template <typename T>
+	std::vector<T> parseList(const juce::String& list, std::vector<T> defaultValues)
+	{
+		if (list.isEmpty())
+		{
+			return defaultValues;
+		}
+
+		std::vector<T> values;
+		for (auto& token : juce::StringArray::fromTokens(list, ",", ""))
+		{
+			values.push_back(static_cast<T>(token.getDoubleValue()));
+		}
+		return values;
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	const auto blockSizes = parseList<int>(ToolUtilities::getStringOption(args, "--block-sizes"), { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 });
+	const auto sampleRates = parseList<double>(ToolUtilities::getStringOption(args, "--sample-rates"), { 44100.0, 48000.0, 96000.0, 192000.0 });
+	const juce::String processorFilter = ToolUtilities::getStringOption(args, "--processor");
+	const double seconds = ToolUtilities::getDoubleOption(args, "--seconds", 0.5);
+	const auto implementation = ToolUtilities::getStringOption(args, "--implementation", "reference") == "optimised" ? DSPImplementation::Optimised : DSPImplementation::Reference;
+	const double tolerance = ToolUtilities::getDoubleOption(args, "--tolerance", 0.1);
+
+	//==============================================================================
+	juce::Array<juce::var> results;
+	for (auto& stageCase : ToolUtilities::createStageCases())
+	{
+		if (processorFilter.isNotEmpty() && processorFilter != stageCase.name)
+		{
+			continue;
+		}
+
+		for (auto sampleRate : sampleRates)
+		{
+			for (auto blockSize : blockSizes)
+			{
+				for (auto state : { ParameterState::Bypassed, ParameterState::Static, ParameterState::Automated })
+				{
+					auto result = runCase(stageCase, { sampleRate, blockSize, state, seconds, implementation });
+					std::cout << getResultKey(result) << ": " << static_cast<double>(result["nsPerSample"]) << " ns/sample" << std::endl;
+					results.add(result);
+				}
+			}
+		}
+	}
+
+	auto* report = new juce::DynamicObject();
+	report->setProperty("benchmark", "processors");
+	report->setProperty("results", results);
+	juce::var json(report);
+
+	//==============================================================================
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		ToolUtilities::writeJson(json, juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	const juce::String baselinePath = ToolUtilities::getStringOption(args, "--baseline");
+	if (baselinePath.isNotEmpty())
+	{
+		auto baselineFile = juce::File::getCurrentWorkingDirectory().getChildFile(baselinePath);
+		if (!baselineFile.existsAsFile() || args.containsOption("--update-baseline"))
+		{
+			ToolUtilities::writeJson(json, baselineFile);
+			std::cout << "baseline written to " << baselineFile.getFullPathName() << std::endl;
+			return 0;
+		}
+
+		const int regressions = compareWithBaseline(json, juce::JSON::parse(baselineFile), tolerance);
+		std::cout << regressions << " regression(s) above " << tolerance * 100.0 << "%" << std::endl;
+		return regressions > 0 ? 1 : 0;
+	}
+
+	return 0;
+}
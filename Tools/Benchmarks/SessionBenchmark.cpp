@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+	SessionBenchmark.cpp
+	Session scaling: N TalkingHeadsPluginAudioProcessor instances driven by M threads like a host's parallel graph
+
+	usage: talkingheads_bench_session [--instances 1,8,16,32,60] [--threads 1,4] [--block-size 256]
+		[--sample-rate 48000] [--seconds 5] [--output results.json]
+
+	Every block period all N instances are processed once; worker threads pull instances from a shared
+	counter until the cycle is done. Reports, per (N, M):
+	- throughput: instance-blocks/s and how many real-time instances that amounts to
+	- per-instance memory: resident set growth from constructing and preparing the instances (Linux)
+	- cache-miss sensitivity: ns and last level cache misses per instance-block as N grows (Linux perf events)
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include "PluginProcessor.h"
+#include "ToolUtilities.h"
+
+#if JUCE_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	//==============================================================================
+	// -- Resident set size in bytes, -1 if unknown
+	juce::int64 getResidentBytes()
+	{
+#if JUCE_LINUX
+		auto statm = juce::File("/proc/self/statm").loadFileAsString();
+		auto tokens = juce::StringArray::fromTokens(statm, " ", "");
+		if (tokens.size() > 1)
+		{
+			return tokens[1].getLargeIntValue() * static_cast<juce::int64>(sysconf(_SC_PAGESIZE));
+		}
+#endif
+		return -1;
+	}
+
+	//==============================================================================
+	// -- Last level cache misses of this process and the threads it creates afterwards
+	class CacheMissCounter
+	{
+	public:
+		CacheMissCounter()
+		{
+#if JUCE_LINUX
+			perf_event_attr attributes{};
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.size = sizeof(attributes);
+			attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+			attributes.disabled = 1;
+			attributes.inherit = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			fd = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+		}
+
+		~CacheMissCounter()
+		{
+#if JUCE_LINUX
+			if (fd >= 0)
+			{
+				close(fd);
+			}
+#endif
+		}
+
+		bool isAvailable() const { return fd >= 0; }
+
+		void start()
+		{
+#if JUCE_LINUX
+			if (fd >= 0)
+			{
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		// -- -1 if not available
+		juce::int64 stop()
+		{
+#if JUCE_LINUX
+			if (fd >= 0)
+			{
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+				juce::int64 count = 0;
+				if (read(fd, &count, sizeof(count)) == sizeof(count))
+				{
+					return count;
+				}
+			}
+#endif
+			return -1;
+		}
+
+	private:
+		int fd{ -1 };
+	};
+
+	//==============================================================================
+	struct Instance
+	{
+		std::unique_ptr<TalkingHeadsPluginAudioProcessor> processor;
+		juce::AudioBuffer<float> buffer;
+		juce::AudioBuffer<float> input;
+		juce::MidiBuffer midi;
+	};
+
+	//==============================================================================
+	// -- One host graph: a coordinator releases a cycle, workers (and the coordinator) pull instances until all are done
+	class SessionGraph
+	{
+	public:
+		SessionGraph(std::vector<Instance>& instances, int numThreads) :
+			instances(instances)
+		{
+			for (int i{ 1 }; i < numThreads; ++i)
+			{
+				workers.emplace_back([this] { workerLoop(); });
+			}
+		}
+
+		~SessionGraph()
+		{
+			shouldExit.store(true);
+			cycle.fetch_add(1);
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+		}
+
+		void runCycle()
+		{
+			// -- a worker late from the previous cycle may claim an instance as soon as nextInstance is reset,
+			// -- so remaining must already hold the new count when it does
+			remaining.store(static_cast<int>(instances.size()), std::memory_order_relaxed);
+			nextInstance.store(0, std::memory_order_release);
+			cycle.fetch_add(1, std::memory_order_release);
+
+			processInstances();
+			while (remaining.load(std::memory_order_acquire) > 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	private:
+		std::vector<Instance>& instances;
+		std::vector<std::thread> workers;
+
+		std::atomic<int> cycle{ 0 };
+		std::atomic<int> nextInstance{ 0 };
+		std::atomic<int> remaining{ 0 };
+		std::atomic<bool> shouldExit{ false };
+
+		void workerLoop()
+		{
+			int lastCycle = 0;
+			while (true)
+			{
+				int currentCycle;
+				while ((currentCycle = cycle.load(std::memory_order_acquire)) == lastCycle)
+				{
+					std::this_thread::yield();
+				}
+				lastCycle = currentCycle;
+
+				if (shouldExit.load())
+				{
+					return;
+				}
+				processInstances();
+			}
+		}
+
+		void processInstances()
+		{
+			const int numInstances = static_cast<int>(instances.size());
+			for (int i = nextInstance.fetch_add(1, std::memory_order_acquire); i < numInstances; i = nextInstance.fetch_add(1, std::memory_order_acquire))
+			{
+				auto& instance = instances[static_cast<size_t>(i)];
+				// -- the host hands each track fresh input
+				instance.buffer.copyFrom(0, 0, instance.input, 0, 0, instance.input.getNumSamples());
+				instance.processor->processBlock(instance.buffer, instance.midi);
+				remaining.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+	};
+
+	//==============================================================================
+	juce::var runSession(int numInstances, int numThreads, int blockSize, double sampleRate, double seconds, CacheMissCounter& cacheMisses)
+	{
+		// -- Construction and prepare, measured as resident set growth
+		const auto residentBefore = getResidentBytes();
+
+		std::vector<Instance> instances(static_cast<size_t>(numInstances));
+		juce::Random random(0x5e55);
+		for (auto& instance : instances)
+		{
+			instance.processor = std::make_unique<TalkingHeadsPluginAudioProcessor>();
+			ToolUtilities::prepareProcessor(*instance.processor, sampleRate, blockSize);
+
+			instance.buffer.setSize(ToolUtilities::getNumProcessingChannels(*instance.processor), blockSize);
+			instance.buffer.clear();
+			instance.input.setSize(1, blockSize);
+			for (int i{ 0 }; i < blockSize; ++i)
+			{
+				instance.input.setSample(0, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+			}
+		}
+
+		const auto residentAfter = getResidentBytes();
+
+		//==============================================================================
+		SessionGraph graph(instances, numThreads);
+
+		const int warmupCycles = 32;
+		const int numCycles = juce::jmax(64, juce::roundToInt(seconds * sampleRate / blockSize));
+
+		for (int i{ 0 }; i < warmupCycles; ++i)
+		{
+			graph.runCycle();
+		}
+
+		std::vector<double> cycleNs;
+		cycleNs.reserve(static_cast<size_t>(numCycles));
+
+		cacheMisses.start();
+		const auto start = juce::Time::getHighResolutionTicks();
+		for (int i{ 0 }; i < numCycles; ++i)
+		{
+			const auto cycleStart = juce::Time::getHighResolutionTicks();
+			graph.runCycle();
+			cycleNs.push_back(ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - cycleStart));
+		}
+		const double totalNs = ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start);
+		const auto misses = cacheMisses.stop();
+
+		//==============================================================================
+		const double instanceBlocks = static_cast<double>(numInstances) * numCycles;
+		const double audioSeconds = numCycles * blockSize / sampleRate;
+		const double realTimeMultiple = audioSeconds / (totalNs * 1.0e-9);
+		const double deadlineNs = 1.0e9 * blockSize / sampleRate;
+		auto cycleSummary = ToolUtilities::summarise(cycleNs);
+
+		auto* result = new juce::DynamicObject();
+		result->setProperty("instances", numInstances);
+		result->setProperty("threads", numThreads);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("instanceBlocksPerSecond", instanceBlocks / (totalNs * 1.0e-9));
+		result->setProperty("nsPerInstanceBlock", totalNs / instanceBlocks);
+		result->setProperty("realTimeInstances", numInstances * realTimeMultiple);
+		result->setProperty("cycleDeadlineNs", deadlineNs);
+		result->setProperty("cycle", ToolUtilities::timingSummaryToVar(cycleSummary));
+		result->setProperty("bytesPerInstance", residentBefore >= 0 ? juce::var(static_cast<double>(residentAfter - residentBefore) / numInstances) : juce::var());
+		result->setProperty("cacheMissesPerInstanceBlock", misses >= 0 ? juce::var(static_cast<double>(misses) / instanceBlocks) : juce::var());
+
+		std::cout << "N=" << numInstances << " M=" << numThreads
+			<< ": " << totalNs / instanceBlocks << " ns/instance-block"
+			<< ", " << numInstances * realTimeMultiple << " real-time instances"
+			<< ", cycle p99 " << cycleSummary.p99Ns / deadlineNs * 100.0 << "% of deadline";
+		if (residentBefore >= 0)
+		{
+			std::cout << ", " << static_cast<double>(residentAfter - residentBefore) / numInstances / 1024.0 << " KiB/instance";
+		}
+		if (misses >= 0)
+		{
+			std::cout << ", " << static_cast<double>(misses) / instanceBlocks << " LLC misses/instance-block";
+		}
+		std::cout << std::endl;
+
+		return juce::var(result);
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	auto parseList = [](const juce::String& list)
+		{
+			std::vector<int> values;
+			for (auto& token : juce::StringArray::fromTokens(list, ",", ""))
+			{
+				values.push_back(token.getIntValue());
+			}
+			return values;
+		};
+
+	const auto instanceCounts = parseList(ToolUtilities::getStringOption(args, "--instances", "1,8,16,32,60"));
+	const auto threadCounts = parseList(ToolUtilities::getStringOption(args, "--threads", "1," + juce::String(juce::SystemStats::getNumCpus())));
+	const int blockSize = ToolUtilities::getIntOption(args, "--block-size", 256);
+	const double sampleRate = ToolUtilities::getDoubleOption(args, "--sample-rate", 48000.0);
+	const double seconds = ToolUtilities::getDoubleOption(args, "--seconds", 5.0);
+
+	// -- Opened before any worker thread exists so the counter is inherited by all of them
+	CacheMissCounter cacheMisses;
+	if (!cacheMisses.isAvailable())
+	{
+		std::cout << "cache miss counter unavailable (perf_event_open), reporting timing only" << std::endl;
+	}
+
+	juce::Array<juce::var> results;
+	for (auto numThreads : threadCounts)
+	{
+		for (auto numInstances : instanceCounts)
+		{
+			results.add(runSession(numInstances, juce::jmax(1, numThreads), blockSize, sampleRate, seconds, cacheMisses));
+		}
+	}
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "session");
+		report->setProperty("results", results);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+	StateBenchmark.cpp
+	Save/restore time of the plugin state, binary against XML
+
+	usage: talkingheads_bench_state [--iterations 2000] [--seed 1] [--output results.json]
+
+	Times what getStateInformation and setStateInformation do, on a PluginStateManager hosted on
+	its own: the binary format (PluginStateFormat) against the XML state the processor used to
+	write (APVTS copyState, createXml, copyXmlToBinary) and still reads through its fallback.
+	Restores alternate between the default state and a random one, so every restore changes every
+	parameter. Also checks that both formats round trip the random state.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <array>
+#include <iostream>
+#include "PluginStateFormat.h"
+#include "StateHostProcessor.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	enum Phases
+	{
+		binarySave,
+		binaryRestore,
+		xmlSave,
+		xmlRestore,
+		//==============================================================================
+		countPhases
+	};
+
+	const std::array<const char*, countPhases> phaseNames{ "binary save", "binary restore", "xml save", "xml restore" };
+
+	//==============================================================================
+	// -- TalkingHeadsPluginAudioProcessor::get/setStateInformation, binary
+	void getBinaryState(PluginStateManager& stateManager, juce::MemoryBlock& destData)
+	{
+		PluginStateFormat::write(stateManager, destData);
+	}
+
+	void setBinaryState(PluginStateManager& stateManager, const juce::MemoryBlock& state)
+	{
+		PluginStateFormat::read(stateManager, state.getData(), static_cast<int>(state.getSize()));
+	}
+
+	// -- XML, as written before the binary format and read by the fallback
+	void getXmlState(PluginStateManager& stateManager, juce::MemoryBlock& destData)
+	{
+		auto state = stateManager.getAPVTS()->copyState();
+		std::unique_ptr<juce::XmlElement> xml(state.createXml());
+		juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+	}
+
+	void setXmlState(PluginStateManager& stateManager, const juce::MemoryBlock& state)
+	{
+		std::unique_ptr<juce::XmlElement> xmlState(juce::AudioProcessor::getXmlFromBinary(state.getData(), static_cast<int>(state.getSize())));
+		if (xmlState.get() != nullptr && xmlState->hasTagName(stateManager.getAPVTS()->state.getType()))
+		{
+			auto tree = juce::ValueTree::fromXml(*xmlState);
+			stateManager.publishParameterSnapshot(PluginStateFormat::getPlainValues(tree));
+			stateManager.getAPVTS()->replaceState(tree);
+		}
+	}
+
+	void randomiseParameters(juce::AudioProcessor& processor, juce::Random& random)
+	{
+		for (auto* parameter : processor.getParameters())
+		{
+			parameter->setValueNotifyingHost(random.nextFloat());
+		}
+	}
+
+	std::vector<float> getNormalisedValues(juce::AudioProcessor& processor)
+	{
+		std::vector<float> values;
+		for (auto* parameter : processor.getParameters())
+		{
+			values.push_back(parameter->getValue());
+		}
+		return values;
+	}
+
+	float getMaxDifference(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		float maxDifference{ 0.f };
+		for (size_t i{ 0 }; i < a.size(); ++i)
+		{
+			maxDifference = juce::jmax(maxDifference, std::abs(a[i] - b[i]));
+		}
+		return maxDifference;
+	}
+
+	template <typename Function>
+	double timeNs(Function&& function)
+	{
+		const auto start = juce::Time::getHighResolutionTicks();
+		function();
+		return ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start);
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	const int iterations = juce::jmax(1, ToolUtilities::getIntOption(args, "--iterations", 2000));
+	juce::Random random(ToolUtilities::getIntOption(args, "--seed", 1));
+
+	StateHostProcessor host;
+	auto stateManager = host.getStateManager();
+
+	//==============================================================================
+	// -- Default and random states in both formats
+	std::array<juce::MemoryBlock, 2> binaryStates;
+	std::array<juce::MemoryBlock, 2> xmlStates;
+	getBinaryState(*stateManager, binaryStates[0]);
+	getXmlState(*stateManager, xmlStates[0]);
+
+	randomiseParameters(host, random);
+	const auto randomValues = getNormalisedValues(host);
+	getBinaryState(*stateManager, binaryStates[1]);
+	getXmlState(*stateManager, xmlStates[1]);
+
+	// -- Round trip, through the default state so every parameter has to be restored
+	setBinaryState(*stateManager, binaryStates[0]);
+	setBinaryState(*stateManager, binaryStates[1]);
+	const float binaryError = getMaxDifference(randomValues, getNormalisedValues(host));
+
+	setXmlState(*stateManager, xmlStates[0]);
+	setXmlState(*stateManager, xmlStates[1]);
+	const float xmlError = getMaxDifference(randomValues, getNormalisedValues(host));
+
+	//==============================================================================
+	std::array<std::vector<double>, countPhases> phaseNs;
+	juce::MemoryBlock destData;
+	for (int i{ 0 }; i < iterations; ++i)
+	{
+		const auto& binaryState = binaryStates[i % 2];
+		const auto& xmlState = xmlStates[i % 2];
+
+		phaseNs[binaryRestore].push_back(timeNs([&] { setBinaryState(*stateManager, binaryState); }));
+		phaseNs[binarySave].push_back(timeNs([&] { getBinaryState(*stateManager, destData); }));
+		phaseNs[xmlRestore].push_back(timeNs([&] { setXmlState(*stateManager, xmlState); }));
+		phaseNs[xmlSave].push_back(timeNs([&] { getXmlState(*stateManager, destData); }));
+	}
+
+	//==============================================================================
+	std::cout << "state size: binary " << binaryStates[1].getSize() << " B, xml " << xmlStates[1].getSize() << " B" << std::endl;
+	std::cout << "round trip max error: binary " << binaryError << ", xml " << xmlError << std::endl;
+	std::cout << juce::String("phase").paddedRight(' ', 20) << juce::String("p50 us").paddedLeft(' ', 12) << juce::String("p99 us").paddedLeft(' ', 12) << std::endl;
+
+	juce::Array<juce::var> phases;
+	for (int phase{ 0 }; phase < countPhases; ++phase)
+	{
+		auto summary = ToolUtilities::summarise(phaseNs[phase]);
+		std::cout << juce::String(phaseNames[phase]).paddedRight(' ', 20)
+			<< juce::String(summary.p50Ns * 1.0e-3, 2).paddedLeft(' ', 12)
+			<< juce::String(summary.p99Ns * 1.0e-3, 2).paddedLeft(' ', 12) << std::endl;
+
+		auto* object = new juce::DynamicObject();
+		object->setProperty("phase", phaseNames[phase]);
+		object->setProperty("timing", ToolUtilities::timingSummaryToVar(summary));
+		phases.add(juce::var(object));
+	}
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "state");
+		report->setProperty("iterations", iterations);
+		report->setProperty("binaryBytes", static_cast<juce::int64>(binaryStates[1].getSize()));
+		report->setProperty("xmlBytes", static_cast<juce::int64>(xmlStates[1].getSize()));
+		report->setProperty("binaryRoundTripError", binaryError);
+		report->setProperty("xmlRoundTripError", xmlError);
+		report->setProperty("phases", phases);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return binaryError < 1.0e-4f && xmlError < 1.0e-4f ? 0 : 1;
+}
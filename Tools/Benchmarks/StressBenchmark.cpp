@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+	StressBenchmark.cpp
+	Worst-case block time of TalkingHeadsPluginAudioProcessor under automation storms
+
+	usage: talkingheads_bench_stress [--block-sizes 32,64,128,256,512,1024] [--sample-rate 48000]
+		[--seconds 10] [--toggle-period 32] [--output results.json]
+
+	Two passes per buffer size on a fresh processor:
+	- static: parameters untouched, the baseline
+	- storm: every ControlID moves every block. Floats (crossovers and filter frequencies included) take a new
+	  value, slope and imager type choices step to the next item, so every block redesigns the EQ pass filters,
+	  the compressor crossovers and the imager filters. Bools (bypasses and mutes) stay off and pulse on for a
+	  single block once every --toggle-period blocks, each at its own offset, so the stage switches are
+	  exercised while every stage keeps running and syncing its parameters; 0 keeps them off.
+
+	Reports p50/p99/p99.9/max block time and a histogram of block time as a percentage of the real-time deadline.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "PluginProcessor.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	// -- Histogram bucket upper edges, in % of the block deadline -- the last bucket is open
+	const std::vector<double> bucketEdges{ 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 75.0, 100.0, 200.0 };
+
+	//==============================================================================
+	void automateAllParameters(juce::AudioProcessor& processor, int block, int togglePeriod)
+	{
+		auto& parameters = processor.getParameters();
+		for (int i{ 0 }; i < parameters.size(); ++i)
+		{
+			auto* parameter = parameters[i];
+			const int numSteps = parameter->getNumSteps();
+			float value;
+			if (parameter->isBoolean())
+			{
+				// -- one block on per period: a bypass held on would skip its stage (and its parameter sync) and understate the worst case
+				value = (togglePeriod > 0 && ((block + i) % togglePeriod) == 0) ? 1.f : 0.f;
+			}
+			else if (parameter->isDiscrete() && numSteps > 1 && numSteps < 64)
+			{
+				value = static_cast<float>((block + i) % numSteps) / static_cast<float>(numSteps - 1);
+			}
+			else
+			{
+				// -- incommensurate with the block index so every block lands on a new value
+				value = 0.5f + 0.5f * std::sin(0.731f * static_cast<float>(block) + static_cast<float>(i));
+			}
+			parameter->setValueNotifyingHost(value);
+		}
+	}
+
+	//==============================================================================
+	juce::var runPass(const juce::String& mode, int blockSize, double sampleRate, double seconds, int togglePeriod)
+	{
+		const bool storm = mode == "storm";
+
+		TalkingHeadsPluginAudioProcessor processor;
+		ToolUtilities::prepareProcessor(processor, sampleRate, blockSize);
+
+		juce::AudioBuffer<float> buffer(ToolUtilities::getNumProcessingChannels(processor), blockSize);
+		juce::MidiBuffer midi;
+		juce::Random random(0x57e5);
+
+		const int warmupBlocks = 64;
+		const int numBlocks = juce::jmax(1000, juce::roundToInt(seconds * sampleRate / blockSize));
+		const double deadlineNs = 1.0e9 * blockSize / sampleRate;
+
+		std::vector<double> blockNs;
+		blockNs.reserve(static_cast<size_t>(numBlocks));
+		std::vector<int> histogram(bucketEdges.size() + 1, 0);
+
+		for (int block{ 0 }; block < warmupBlocks + numBlocks; ++block)
+		{
+			if (storm)
+			{
+				automateAllParameters(processor, block, togglePeriod);
+			}
+
+			buffer.clear();
+			auto* input = buffer.getWritePointer(0);
+			for (int i{ 0 }; i < blockSize; ++i)
+			{
+				input[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+			}
+
+			const auto start = juce::Time::getHighResolutionTicks();
+			processor.processBlock(buffer, midi);
+			const double ns = ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start);
+
+			if (block < warmupBlocks)
+			{
+				continue;
+			}
+
+			blockNs.push_back(ns);
+			const double percentOfDeadline = ns / deadlineNs * 100.0;
+			size_t bucket = 0;
+			while (bucket < bucketEdges.size() && percentOfDeadline >= bucketEdges[bucket])
+			{
+				++bucket;
+			}
+			++histogram[bucket];
+		}
+
+		processor.releaseResources();
+
+		//==============================================================================
+		auto summary = ToolUtilities::summarise(blockNs);
+
+		std::cout << "block size " << blockSize << ", " << mode << " (deadline " << deadlineNs / 1000.0 << " us, " << summary.count << " blocks)" << std::endl;
+		std::cout << "  p50 " << summary.p50Ns / deadlineNs * 100.0 << "%, p99 " << summary.p99Ns / deadlineNs * 100.0
+			<< "%, p99.9 " << summary.p999Ns / deadlineNs * 100.0 << "%, max " << summary.maxNs / deadlineNs * 100.0 << "% of deadline" << std::endl;
+
+		juce::Array<juce::var> buckets;
+		for (size_t bucket{ 0 }; bucket < histogram.size(); ++bucket)
+		{
+			const juce::String lower = bucket == 0 ? "0" : juce::String(bucketEdges[bucket - 1]);
+			const juce::String upper = bucket < bucketEdges.size() ? juce::String(bucketEdges[bucket]) : "inf";
+			const double fraction = static_cast<double>(histogram[bucket]) / juce::jmax(1, summary.count);
+
+			std::cout << "  " << (lower + "-" + upper + "%").paddedRight(' ', 12)
+				<< juce::String(histogram[bucket]).paddedLeft(' ', 8) << " "
+				<< juce::String::repeatedString("#", juce::roundToInt(fraction * 50.0)) << std::endl;
+
+			auto* object = new juce::DynamicObject();
+			object->setProperty("lowerPercent", bucket == 0 ? 0.0 : bucketEdges[bucket - 1]);
+			object->setProperty("upperPercent", bucket < bucketEdges.size() ? juce::var(bucketEdges[bucket]) : juce::var());
+			object->setProperty("count", histogram[bucket]);
+			buckets.add(juce::var(object));
+		}
+
+		auto* result = new juce::DynamicObject();
+		result->setProperty("mode", mode);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("deadlineNs", deadlineNs);
+		result->setProperty("timing", ToolUtilities::timingSummaryToVar(summary));
+		result->setProperty("missedDeadlines", histogram[bucketEdges.size() - 1] + histogram[bucketEdges.size()]);
+		result->setProperty("histogram", buckets);
+		return juce::var(result);
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	std::vector<int> blockSizes;
+	for (auto& token : juce::StringArray::fromTokens(ToolUtilities::getStringOption(args, "--block-sizes", "32,64,128,256,512,1024"), ",", ""))
+	{
+		blockSizes.push_back(token.getIntValue());
+	}
+	const double sampleRate = ToolUtilities::getDoubleOption(args, "--sample-rate", 48000.0);
+	const double seconds = ToolUtilities::getDoubleOption(args, "--seconds", 10.0);
+	const int togglePeriod = juce::jmax(0, ToolUtilities::getIntOption(args, "--toggle-period", 32));
+
+	juce::Array<juce::var> results;
+	for (auto blockSize : blockSizes)
+	{
+		results.add(runPass("static", blockSize, sampleRate, seconds, togglePeriod));
+		results.add(runPass("storm", blockSize, sampleRate, seconds, togglePeriod));
+	}
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "stress");
+		report->setProperty("results", results);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+	StageCases.cpp
+
+  ==============================================================================
+*/
+
+#include "StageCases.h"
+#include "CompressorBand.h"
+#include "EQBand.h"
+#include "Imager.h"
+#include "MultiBandCompressor.h"
+#include "MultiBandEQ.h"
+
+namespace ToolUtilities
+{
+	//==============================================================================
+	std::vector<StageCase> createStageCases()
+	{
+		std::vector<StageCase> cases;
+
+		cases.push_back({
+			"EQBand",
+			1,
+			true,
+			{ ControlID::bandFilter1Bypass },
+			{ ControlID::bandFilter1PeakFreq, ControlID::bandFilter1PeakGain, ControlID::bandFilter1PeakQ },
+			[](std::shared_ptr<PluginStateManager> stateManager, DSPImplementation implementation)
+			{
+				auto stage = std::make_unique<EQBand>(
+					stateManager,
+					ControlID::bandFilter1Bypass,
+					ControlID::bandFilter1PeakFreq,
+					ControlID::bandFilter1PeakGain,
+					ControlID::bandFilter1PeakQ
+				);
+				stage->setImplementation(implementation);
+				return stage;
+			}
+			});
+
+		// -- Mid band: highpass + lowpass crossovers, the most expensive band
+		cases.push_back({
+			"CompressorBand",
+			1,
+			false,
+			{ ControlID::midBandCompressorBypass },
+			{
+				ControlID::lowMidCrossoverFreq,
+				ControlID::midHighCrossoverFreq,
+				ControlID::midBandCompressorThreshold,
+				ControlID::midBandCompressorAttack,
+				ControlID::midBandCompressorRelease,
+				ControlID::midBandCompressorRatio
+			},
+			[](std::shared_ptr<PluginStateManager> stateManager, DSPImplementation)
+			{
+				auto stage = std::make_unique<CompressorBand>(
+					stateManager,
+					ControlID::midBandCompressorMute,
+					ControlID::midBandCompressorBypass,
+					ControlID::midBandCompressorThreshold,
+					ControlID::midBandCompressorAttack,
+					ControlID::midBandCompressorRelease,
+					ControlID::midBandCompressorRatio,
+					ControlID::lowMidCrossoverFreq,
+					ControlID::midHighCrossoverFreq,
+					juce::dsp::LinkwitzRileyFilterType::highpass,
+					juce::dsp::LinkwitzRileyFilterType::lowpass
+				);
+				return stage;
+			}
+			});
+
+		cases.push_back({
+			"MultiBandCompressor",
+			1,
+			false,
+			{ ControlID::compressorBypass },
+			{
+				ControlID::lowMidCrossoverFreq,
+				ControlID::midHighCrossoverFreq,
+				ControlID::lowBandCompressorThreshold,
+				ControlID::lowBandCompressorRatio,
+				ControlID::midBandCompressorThreshold,
+				ControlID::midBandCompressorRatio,
+				ControlID::highBandCompressorThreshold,
+				ControlID::highBandCompressorRatio
+			},
+			[](std::shared_ptr<PluginStateManager> stateManager, DSPImplementation)
+			{
+				auto stage = std::make_unique<MultiBandCompressor>(
+					stateManager,
+					ControlID::compressorBypass,
+					ControlID::lowMidCrossoverFreq,
+					ControlID::midHighCrossoverFreq,
+					MultiBandCompressor::CompressorBandParamIDs{
+						ControlID::lowBandCompressorMute,
+						ControlID::lowBandCompressorBypass,
+						ControlID::lowBandCompressorThreshold,
+						ControlID::lowBandCompressorAttack,
+						ControlID::lowBandCompressorRelease,
+						ControlID::lowBandCompressorRatio
+					},
+					MultiBandCompressor::CompressorBandParamIDs{
+						ControlID::midBandCompressorMute,
+						ControlID::midBandCompressorBypass,
+						ControlID::midBandCompressorThreshold,
+						ControlID::midBandCompressorAttack,
+						ControlID::midBandCompressorRelease,
+						ControlID::midBandCompressorRatio
+					},
+					MultiBandCompressor::CompressorBandParamIDs{
+						ControlID::highBandCompressorMute,
+						ControlID::highBandCompressorBypass,
+						ControlID::highBandCompressorThreshold,
+						ControlID::highBandCompressorAttack,
+						ControlID::highBandCompressorRelease,
+						ControlID::highBandCompressorRatio
+					}
+				);
+				return stage;
+			}
+			});
+
+		cases.push_back({
+			"MultiBandEQ",
+			1,
+			true,
+			{
+				ControlID::highpassBypass,
+				ControlID::lowpassBypass,
+				ControlID::bandFilter1Bypass,
+				ControlID::bandFilter2Bypass,
+				ControlID::bandFilter3Bypass
+			},
+			{
+				ControlID::highpassFreq,
+				ControlID::highpassSlope,
+				ControlID::lowpassFreq,
+				ControlID::lowpassSlope,
+				ControlID::bandFilter1PeakFreq,
+				ControlID::bandFilter1PeakGain,
+				ControlID::bandFilter1PeakQ,
+				ControlID::bandFilter2PeakFreq,
+				ControlID::bandFilter2PeakGain,
+				ControlID::bandFilter2PeakQ,
+				ControlID::bandFilter3PeakFreq,
+				ControlID::bandFilter3PeakGain,
+				ControlID::bandFilter3PeakQ
+			},
+			[](std::shared_ptr<PluginStateManager> stateManager, DSPImplementation implementation)
+			{
+				auto stage = std::make_unique<MultiBandEQ>(
+					stateManager,
+					MultiBandEQ::EQBandParamIDs{
+						ControlID::bandFilter1Bypass,
+						ControlID::bandFilter1PeakFreq,
+						ControlID::bandFilter1PeakGain,
+						ControlID::bandFilter1PeakQ
+					},
+					MultiBandEQ::EQBandParamIDs{
+						ControlID::bandFilter2Bypass,
+						ControlID::bandFilter2PeakFreq,
+						ControlID::bandFilter2PeakGain,
+						ControlID::bandFilter2PeakQ
+					},
+					MultiBandEQ::EQBandParamIDs{
+						ControlID::bandFilter3Bypass,
+						ControlID::bandFilter3PeakFreq,
+						ControlID::bandFilter3PeakGain,
+						ControlID::bandFilter3PeakQ
+					}
+				);
+				stage->setImplementation(implementation);
+				return stage;
+			}
+			});
+
+		cases.push_back({
+			"Imager",
+			2,
+			false,
+			{ ControlID::imagerBypass },
+			{
+				ControlID::imagerOriginalGain,
+				ControlID::imagerAuxiliarGain,
+				ControlID::imagerWidth,
+				ControlID::imagerCenter,
+				ControlID::imagerDelayTime,
+				ControlID::imagerCrossoverFreq,
+				ControlID::imagerType
+			},
+			[](std::shared_ptr<PluginStateManager> stateManager, DSPImplementation)
+			{
+				auto stage = std::make_unique<Imager>(stateManager);
+				return stage;
+			}
+			});
+
+		return cases;
+	}
+}
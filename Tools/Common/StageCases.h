@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+	StageCases.h
+	The DSP stages the benchmarks and the equivalence harness drive in isolation,
+	with the ControlIDs each one bypasses and automates
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "DSPImplementation.h"
+#include "PluginStateManager.h"
+
+namespace ToolUtilities
+{
+	//==============================================================================
+	// -- create builds the stage wired to the given state manager, running the given implementation;
+	// -- stages without an Optimised kernel (hasOptimised false) ignore it and always run Reference
+	struct StageCase
+	{
+		juce::String name;
+		int numChannels;
+		bool hasOptimised;
+		std::vector<ControlID> bypassIDs;
+		std::vector<ControlID> automatedIDs;
+		std::function<std::unique_ptr<juce::dsp::ProcessorBase>(std::shared_ptr<PluginStateManager>, DSPImplementation)> create;
+	};
+
+	std::vector<StageCase> createStageCases();
+}
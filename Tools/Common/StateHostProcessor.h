@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+	StateHostProcessor.h
+	Minimal AudioProcessor that only owns a PluginStateManager, so the DSP stages
+	can be driven in isolation outside TalkingHeadsPluginAudioProcessor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include "PluginStateManager.h"
+
+//==============================================================================
+class StateHostProcessor : public juce::AudioProcessor
+{
+public:
+	//==============================================================================
+	StateHostProcessor() :
+		AudioProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::mono(), true).withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+		stateManager(std::make_shared<PluginStateManager>(*this, nullptr, juce::Identifier("ParametersAPVTS")))
+	{
+	}
+
+	//==============================================================================
+	std::shared_ptr<PluginStateManager> getStateManager() { return stateManager; }
+
+	// -- Sets a parameter from its plain (denormalised) value
+	void setParameterValue(ControlID controlID, float plainValue)
+	{
+		auto* parameter = stateManager->getParameter(controlID);
+		parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+	}
+
+	void setParameterNormalisedValue(ControlID controlID, float normalisedValue)
+	{
+		stateManager->getParameter(controlID)->setValueNotifyingHost(normalisedValue);
+	}
+
+	//==============================================================================
+	void prepareToPlay(double, int) override {}
+	void releaseResources() override {}
+	void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+
+	juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+	bool hasEditor() const override { return false; }
+
+	const juce::String getName() const override { return "StateHost"; }
+	bool acceptsMidi() const override { return false; }
+	bool producesMidi() const override { return false; }
+	double getTailLengthSeconds() const override { return 0.0; }
+
+	int getNumPrograms() override { return 1; }
+	int getCurrentProgram() override { return 0; }
+	void setCurrentProgram(int) override {}
+	const juce::String getProgramName(int) override { return {}; }
+	void changeProgramName(int, const juce::String&) override {}
+
+	void getStateInformation(juce::MemoryBlock&) override {}
+	void setStateInformation(const void*, int) override {}
+
+private:
+	//==============================================================================
+	std::shared_ptr<PluginStateManager> stateManager;
+
+	//==============================================================================
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StateHostProcessor)
+};
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+	ToolUtilities.cpp
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <numeric>
+#include "ToolUtilities.h"
+
+namespace ToolUtilities
+{
+	//==============================================================================
+	// -- Command line
+	int getIntOption(const juce::ArgumentList& args, const juce::String& option, int defaultValue)
+	{
+		auto value = args.getValueForOption(option);
+		return value.isEmpty() ? defaultValue : value.getIntValue();
+	}
+
+	double getDoubleOption(const juce::ArgumentList& args, const juce::String& option, double defaultValue)
+	{
+		auto value = args.getValueForOption(option);
+		return value.isEmpty() ? defaultValue : value.getDoubleValue();
+	}
+
+	juce::String getStringOption(const juce::ArgumentList& args, const juce::String& option, const juce::String& defaultValue)
+	{
+		auto value = args.getValueForOption(option);
+		return value.isEmpty() ? defaultValue : value;
+	}
+
+	//==============================================================================
+	// -- Processor hosting
+	void prepareProcessor(juce::AudioProcessor& processor, double sampleRate, int blockSize)
+	{
+		juce::AudioProcessor::BusesLayout layout;
+		layout.inputBuses.add(juce::AudioChannelSet::mono());
+		layout.outputBuses.add(juce::AudioChannelSet::stereo());
+		processor.setBusesLayout(layout);
+
+		processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+	}
+
+	int getNumProcessingChannels(const juce::AudioProcessor& processor)
+	{
+		return juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+	}
+
+	//==============================================================================
+	// -- Timing
+	double ticksToNanoseconds(juce::int64 ticks)
+	{
+		static const double nanosecondsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+		return static_cast<double>(ticks) * nanosecondsPerTick;
+	}
+
+	TimingSummary summarise(std::vector<double>& samplesNs)
+	{
+		TimingSummary summary;
+		if (samplesNs.empty())
+		{
+			return summary;
+		}
+
+		std::sort(samplesNs.begin(), samplesNs.end());
+
+		auto percentile = [&samplesNs](double fraction)
+			{
+				auto idx = static_cast<size_t>(fraction * static_cast<double>(samplesNs.size() - 1) + 0.5);
+				return samplesNs[std::min(idx, samplesNs.size() - 1)];
+			};
+
+		summary.count = static_cast<int>(samplesNs.size());
+		summary.totalNs = std::accumulate(samplesNs.begin(), samplesNs.end(), 0.0);
+		summary.minNs = samplesNs.front();
+		summary.maxNs = samplesNs.back();
+		summary.meanNs = summary.totalNs / static_cast<double>(summary.count);
+		summary.p50Ns = percentile(0.5);
+		summary.p99Ns = percentile(0.99);
+		summary.p999Ns = percentile(0.999);
+
+		return summary;
+	}
+
+	//==============================================================================
+	// -- Reports
+	juce::var timingSummaryToVar(const TimingSummary& summary)
+	{
+		auto* object = new juce::DynamicObject();
+		object->setProperty("count", summary.count);
+		object->setProperty("minNs", summary.minNs);
+		object->setProperty("meanNs", summary.meanNs);
+		object->setProperty("p50Ns", summary.p50Ns);
+		object->setProperty("p99Ns", summary.p99Ns);
+		object->setProperty("p999Ns", summary.p999Ns);
+		object->setProperty("maxNs", summary.maxNs);
+		object->setProperty("totalNs", summary.totalNs);
+		return juce::var(object);
+	}
+
+	bool writeJson(const juce::var& json, const juce::File& file)
+	{
+		return file.replaceWithText(juce::JSON::toString(json));
+	}
+}
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+	ToolUtilities.h
+	Helpers shared by the headless render and benchmark tools
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace ToolUtilities
+{
+	//==============================================================================
+	// -- Command line
+	int getIntOption(const juce::ArgumentList& args, const juce::String& option, int defaultValue);
+	double getDoubleOption(const juce::ArgumentList& args, const juce::String& option, double defaultValue);
+	juce::String getStringOption(const juce::ArgumentList& args, const juce::String& option, const juce::String& defaultValue = {});
+
+	//==============================================================================
+	// -- Processor hosting
+	// -- Sets the mono in / stereo out layout, the play config and calls prepareToPlay
+	void prepareProcessor(juce::AudioProcessor& processor, double sampleRate, int blockSize);
+	// -- Buffer wide enough for the processor's input and output channels
+	int getNumProcessingChannels(const juce::AudioProcessor& processor);
+
+	//==============================================================================
+	// -- Timing
+	double ticksToNanoseconds(juce::int64 ticks);
+
+	struct TimingSummary
+	{
+		double minNs{ 0.0 };
+		double meanNs{ 0.0 };
+		double p50Ns{ 0.0 };
+		double p99Ns{ 0.0 };
+		double p999Ns{ 0.0 };
+		double maxNs{ 0.0 };
+		double totalNs{ 0.0 };
+		int count{ 0 };
+	};
+
+	// -- Sorts the given samples
+	TimingSummary summarise(std::vector<double>& samplesNs);
+
+	//==============================================================================
+	// -- Reports
+	juce::var timingSummaryToVar(const TimingSummary& summary);
+	bool writeJson(const juce::var& json, const juce::File& file);
+}
@@ -0,0 +1,404 @@
+/*
+  ==============================================================================
+
+	EquivalenceMain.cpp
+	Numerical equivalence of a candidate DSPImplementation against the Reference one, stage by stage
+
+	usage: talkingheads_equivalence [--candidate optimised] [--processor EQBand] [--block-sizes 32,256,1000]
+		[--sample-rates 44100,48000,96000] [--seconds 1] [--max-abs-error 1e-4] [--min-snr 90] [--max-null -90]
+		[--output results.json]
+
+	Both implementations are built on the same state manager, so each block they see exactly the same
+	smoothed parameter values, and they process copies of the same input. Every stage is run over each
+	test signal (noise, log sweep, impulses, gated bursts) and parameter trajectory (static, automated every
+	block, stepped jumps including bypass toggles). Per case it reports:
+	- max abs error: largest sample difference over all output channels
+	- SNR: reference energy over difference energy, in dB
+	- null depth: peak of the difference relative to the reference peak, in dB
+	Returns 1 if any case exceeds a tolerance or the candidate produces a non finite sample.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include "StageCases.h"
+#include "StateHostProcessor.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	enum class TestSignal
+	{
+		Noise,
+		Sweep,
+		Impulses,
+		Bursts,
+		//==============================================================================
+		countSignals
+	};
+
+	enum class Trajectory
+	{
+		Static,
+		Automated,
+		Stepped,
+		//==============================================================================
+		countTrajectories
+	};
+
+	juce::String toString(TestSignal signal)
+	{
+		switch (signal)
+		{
+		case TestSignal::Noise:
+			return "noise";
+		case TestSignal::Sweep:
+			return "sweep";
+		case TestSignal::Impulses:
+			return "impulses";
+		case TestSignal::Bursts:
+			return "bursts";
+		default:
+			return {};
+		}
+	}
+
+	juce::String toString(Trajectory trajectory)
+	{
+		switch (trajectory)
+		{
+		case Trajectory::Static:
+			return "static";
+		case Trajectory::Automated:
+			return "automated";
+		case Trajectory::Stepped:
+			return "stepped";
+		default:
+			return {};
+		}
+	}
+
+	//==============================================================================
+	// -- Deterministic test signal generator, one sample at a time
+	class SignalGenerator
+	{
+	public:
+		SignalGenerator(TestSignal signal, double sampleRate, juce::int64 lengthInSamples) :
+			signal(signal),
+			sampleRate(sampleRate),
+			lengthInSamples(juce::jmax<juce::int64>(1, lengthInSamples))
+		{
+		}
+
+		float getNextSample()
+		{
+			float sample = 0.f;
+			switch (signal)
+			{
+			case TestSignal::Noise:
+				sample = (random.nextFloat() * 2.f - 1.f) * 0.5f;
+				break;
+			case TestSignal::Sweep:
+			{
+				// -- log sweep 20 Hz -> 20 kHz over the whole run
+				const double progress = static_cast<double>(position) / static_cast<double>(lengthInSamples);
+				const double frequency = 20.0 * std::pow(1000.0, progress);
+				phase += juce::MathConstants<double>::twoPi * frequency / sampleRate;
+				sample = 0.5f * static_cast<float>(std::sin(phase));
+				break;
+			}
+			case TestSignal::Impulses:
+				sample = (position % static_cast<juce::int64>(sampleRate / 10.0)) == 0 ? 1.f : 0.f;
+				break;
+			case TestSignal::Bursts:
+			{
+				// -- 50 ms of loud noise every 250 ms, silence in between, exercises attack/release
+				const bool gateOpen = (position % static_cast<juce::int64>(sampleRate / 4.0)) < static_cast<juce::int64>(sampleRate / 20.0);
+				sample = gateOpen ? (random.nextFloat() * 2.f - 1.f) * 0.9f : 0.f;
+				break;
+			}
+			default:
+				break;
+			}
+
+			++position;
+			return sample;
+		}
+
+	private:
+		TestSignal signal;
+		double sampleRate;
+		juce::int64 lengthInSamples;
+		juce::int64 position{ 0 };
+		double phase{ 0.0 };
+		juce::Random random{ 0xe9a1 };
+	};
+
+	//==============================================================================
+	struct Tolerances
+	{
+		double maxAbsError;
+		double minSnrDb;
+		double maxNullDb;
+	};
+
+	struct ErrorMetrics
+	{
+		double referenceEnergy{ 0.0 };
+		double errorEnergy{ 0.0 };
+		double maxAbsError{ 0.0 };
+		double maxAbsReference{ 0.0 };
+		bool allFinite{ true };
+
+		void add(const float* reference, const float* candidate, int numSamples)
+		{
+			for (int i{ 0 }; i < numSamples; ++i)
+			{
+				if (!std::isfinite(candidate[i]))
+				{
+					allFinite = false;
+					continue;
+				}
+				const double error = static_cast<double>(candidate[i]) - static_cast<double>(reference[i]);
+				referenceEnergy += static_cast<double>(reference[i]) * reference[i];
+				errorEnergy += error * error;
+				maxAbsError = juce::jmax(maxAbsError, std::abs(error));
+				maxAbsReference = juce::jmax(maxAbsReference, static_cast<double>(std::abs(reference[i])));
+			}
+		}
+
+		// -- +inf when the outputs are identical
+		double getSnrDb() const
+		{
+			if (errorEnergy <= 0.0)
+			{
+				return std::numeric_limits<double>::infinity();
+			}
+			return 10.0 * std::log10(juce::jmax(referenceEnergy, std::numeric_limits<double>::min()) / errorEnergy);
+		}
+
+		// -- -inf when the outputs are identical
+		double getNullDepthDb() const
+		{
+			if (maxAbsError <= 0.0)
+			{
+				return -std::numeric_limits<double>::infinity();
+			}
+			return 20.0 * std::log10(maxAbsError / juce::jmax(maxAbsReference, std::numeric_limits<double>::min()));
+		}
+
+		bool passes(const Tolerances& tolerances) const
+		{
+			return allFinite
+				&& maxAbsError <= tolerances.maxAbsError
+				&& getSnrDb() >= tolerances.minSnrDb
+				&& getNullDepthDb() <= tolerances.maxNullDb;
+		}
+	};
+
+	//==============================================================================
+	struct CaseConfig
+	{
+		double sampleRate;
+		int blockSize;
+		TestSignal signal;
+		Trajectory trajectory;
+		double seconds;
+		DSPImplementation candidate;
+	};
+
+	void setTrajectoryValues(StateHostProcessor& host, const ToolUtilities::StageCase& stageCase, Trajectory trajectory, int block, juce::Random& random)
+	{
+		switch (trajectory)
+		{
+		case Trajectory::Static:
+			break;
+		case Trajectory::Automated:
+		{
+			const float phase = static_cast<float>(block) * 0.05f;
+			for (size_t i{ 0 }; i < stageCase.automatedIDs.size(); ++i)
+			{
+				host.setParameterNormalisedValue(stageCase.automatedIDs[i], 0.5f + 0.45f * std::sin(phase + static_cast<float>(i)));
+			}
+			break;
+		}
+		case Trajectory::Stepped:
+		{
+			// -- jumps every 37 blocks, bypasses engaged for one interval out of four
+			if (block % 37 != 0)
+			{
+				break;
+			}
+			for (auto automatedID : stageCase.automatedIDs)
+			{
+				host.setParameterNormalisedValue(automatedID, random.nextFloat());
+			}
+			for (auto bypassID : stageCase.bypassIDs)
+			{
+				host.setParameterValue(bypassID, (block / 37) % 4 == 3 ? 1.f : 0.f);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	ErrorMetrics runCase(const ToolUtilities::StageCase& stageCase, const CaseConfig& config)
+	{
+		StateHostProcessor host;
+		auto stateManager = host.getStateManager();
+		stateManager->syncInBoundVariables(config.blockSize);
+		stateManager->initSmoothedValues(config.sampleRate, config.blockSize);
+
+		auto reference = stageCase.create(stateManager, DSPImplementation::Reference);
+		auto candidate = stageCase.create(stateManager, config.candidate);
+
+		juce::dsp::ProcessSpec spec{ config.sampleRate, static_cast<juce::uint32>(config.blockSize), static_cast<juce::uint32>(stageCase.numChannels) };
+		reference->prepare(spec);
+		candidate->prepare(spec);
+
+		juce::AudioBuffer<float> referenceBuffer(stageCase.numChannels, config.blockSize);
+		juce::AudioBuffer<float> candidateBuffer(stageCase.numChannels, config.blockSize);
+
+		const int numBlocks = juce::jmax(16, juce::roundToInt(config.seconds * config.sampleRate / config.blockSize));
+		SignalGenerator generator(config.signal, config.sampleRate, static_cast<juce::int64>(numBlocks) * config.blockSize);
+		juce::Random random(0x51e9);
+		ErrorMetrics metrics;
+
+		for (int block{ 0 }; block < numBlocks; ++block)
+		{
+			setTrajectoryValues(host, stageCase, config.trajectory, block, random);
+			stateManager->syncInBoundVariables(config.blockSize);
+
+			referenceBuffer.clear();
+			auto* input = referenceBuffer.getWritePointer(0);
+			for (int i{ 0 }; i < config.blockSize; ++i)
+			{
+				input[i] = generator.getNextSample();
+			}
+			candidateBuffer.makeCopyOf(referenceBuffer, true);
+
+			juce::dsp::AudioBlock<float> referenceBlock(referenceBuffer);
+			juce::dsp::AudioBlock<float> candidateBlock(candidateBuffer);
+			reference->process(juce::dsp::ProcessContextReplacing<float>(referenceBlock));
+			candidate->process(juce::dsp::ProcessContextReplacing<float>(candidateBlock));
+
+			for (int channel{ 0 }; channel < stageCase.numChannels; ++channel)
+			{
+				metrics.add(referenceBuffer.getReadPointer(channel), candidateBuffer.getReadPointer(channel), config.blockSize);
+			}
+		}
+
+		return metrics;
+	}
+
+	//==============================================================================
+	template <typename T>
+	std::vector<T> parseList(const juce::String& list)
+	{
+		std::vector<T> values;
+		for (auto& token : juce::StringArray::fromTokens(list, ",", ""))
+		{
+			values.push_back(static_cast<T>(token.getDoubleValue()));
+		}
+		return values;
+	}
+
+	// -- JSON has no infinities
+	juce::var finiteOrVoid(double value)
+	{
+		return std::isfinite(value) ? juce::var(value) : juce::var();
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	const auto candidate = ToolUtilities::getStringOption(args, "--candidate", "optimised") == "reference" ? DSPImplementation::Reference : DSPImplementation::Optimised;
+	const juce::String processorFilter = ToolUtilities::getStringOption(args, "--processor");
+	const auto blockSizes = parseList<int>(ToolUtilities::getStringOption(args, "--block-sizes", "32,256,1000"));
+	const auto sampleRates = parseList<double>(ToolUtilities::getStringOption(args, "--sample-rates", "44100,48000,96000"));
+	const double seconds = ToolUtilities::getDoubleOption(args, "--seconds", 1.0);
+	const Tolerances tolerances{
+		ToolUtilities::getDoubleOption(args, "--max-abs-error", 1.0e-4),
+		ToolUtilities::getDoubleOption(args, "--min-snr", 90.0),
+		ToolUtilities::getDoubleOption(args, "--max-null", -90.0)
+	};
+
+	std::cout << "tolerances: max abs error " << tolerances.maxAbsError << ", SNR >= " << tolerances.minSnrDb
+		<< " dB, null depth <= " << tolerances.maxNullDb << " dB" << std::endl;
+
+	//==============================================================================
+	juce::Array<juce::var> results;
+	int failures = 0;
+	for (auto& stageCase : ToolUtilities::createStageCases())
+	{
+		if (processorFilter.isNotEmpty() && processorFilter != stageCase.name)
+		{
+			continue;
+		}
+		if (candidate == DSPImplementation::Optimised && !stageCase.hasOptimised)
+		{
+			std::cout << stageCase.name << ": reference only, no optimised kernel to compare" << std::endl;
+			continue;
+		}
+
+		for (auto sampleRate : sampleRates)
+		{
+			for (auto blockSize : blockSizes)
+			{
+				for (int signal{ 0 }; signal < enumToInt(TestSignal::countSignals); ++signal)
+				{
+					for (int trajectory{ 0 }; trajectory < enumToInt(Trajectory::countTrajectories); ++trajectory)
+					{
+						const CaseConfig config{ sampleRate, blockSize, intToEnum(signal, TestSignal), intToEnum(trajectory, Trajectory), seconds, candidate };
+						const auto metrics = runCase(stageCase, config);
+						const bool passed = metrics.passes(tolerances);
+						failures += passed ? 0 : 1;
+
+						const juce::String key = stageCase.name + "|" + juce::String(sampleRate) + "|" + juce::String(blockSize)
+							+ "|" + toString(config.signal) + "|" + toString(config.trajectory);
+						std::cout << key << ": max abs error " << metrics.maxAbsError << ", SNR " << metrics.getSnrDb()
+							<< " dB, null " << metrics.getNullDepthDb() << " dB"
+							<< (metrics.allFinite ? "" : ", NON FINITE OUTPUT") << (passed ? "" : "  FAIL") << std::endl;
+
+						auto* result = new juce::DynamicObject();
+						result->setProperty("processor", stageCase.name);
+						result->setProperty("sampleRate", sampleRate);
+						result->setProperty("blockSize", blockSize);
+						result->setProperty("signal", toString(config.signal));
+						result->setProperty("trajectory", toString(config.trajectory));
+						result->setProperty("maxAbsError", metrics.maxAbsError);
+						result->setProperty("snrDb", finiteOrVoid(metrics.getSnrDb()));
+						result->setProperty("nullDepthDb", finiteOrVoid(metrics.getNullDepthDb()));
+						result->setProperty("finite", metrics.allFinite);
+						result->setProperty("passed", passed);
+						results.add(juce::var(result));
+					}
+				}
+			}
+		}
+	}
+
+	std::cout << failures << " case(s) outside tolerance" << std::endl;
+
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	if (outputPath.isNotEmpty())
+	{
+		auto* report = new juce::DynamicObject();
+		report->setProperty("benchmark", "equivalence");
+		report->setProperty("candidate", candidate == DSPImplementation::Optimised ? "optimised" : "reference");
+		report->setProperty("results", results);
+		ToolUtilities::writeJson(juce::var(report), juce::File::getCurrentWorkingDirectory().getChildFile(outputPath));
+	}
+
+	return failures > 0 ? 1 : 0;
+}
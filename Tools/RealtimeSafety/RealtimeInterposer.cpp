@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+	RealtimeInterposer.cpp
+
+  ==============================================================================
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <new>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include "RealtimeInterposer.h"
+
+//==============================================================================
+// -- glibc entry points the replacements forward to
+extern "C"
+{
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+	void* __libc_memalign(std::size_t alignment, std::size_t size);
+	void __libc_free(void* ptr);
+}
+
+namespace RealtimeInterposer
+{
+	namespace
+	{
+		//==============================================================================
+		// -- constant initialised, safe to touch from inside malloc
+		thread_local int realtimeDepth{ 0 };
+		thread_local bool isRecording{ false };
+
+		Violation violations[maxViolations];
+		std::atomic<int> numViolations{ 0 };
+		std::atomic<int> numDroppedViolations{ 0 };
+
+		using MutexFunction = int (*)(pthread_mutex_t*);
+		MutexFunction realMutexLock{ nullptr };
+		MutexFunction realMutexTryLock{ nullptr };
+
+		//==============================================================================
+		void record(ViolationKind kind, std::size_t size)
+		{
+			if (realtimeDepth == 0 || isRecording)
+			{
+				return;
+			}
+
+			isRecording = true; // -- anything backtrace does is not the audio code's fault
+
+			int index = numViolations.fetch_add(1, std::memory_order_relaxed);
+			if (index < maxViolations)
+			{
+				auto& violation = violations[index];
+				violation.kind = kind;
+				violation.size = size;
+				violation.numFrames = backtrace(violation.frames, maxFrames);
+			}
+			else
+			{
+				numViolations.fetch_sub(1, std::memory_order_relaxed);
+				numDroppedViolations.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			isRecording = false;
+		}
+
+		MutexFunction resolve(MutexFunction& function, const char* name)
+		{
+			if (function == nullptr)
+			{
+				function = reinterpret_cast<MutexFunction>(dlsym(RTLD_NEXT, name));
+			}
+			return function;
+		}
+	}
+
+	//==============================================================================
+	const char* toString(ViolationKind kind)
+	{
+		switch (kind)
+		{
+		case ViolationKind::Malloc:
+			return "malloc";
+		case ViolationKind::Calloc:
+			return "calloc";
+		case ViolationKind::Realloc:
+			return "realloc";
+		case ViolationKind::AlignedAlloc:
+			return "aligned alloc";
+		case ViolationKind::Free:
+			return "free";
+		case ViolationKind::OperatorNew:
+			return "operator new";
+		case ViolationKind::OperatorDelete:
+			return "operator delete";
+		case ViolationKind::MutexLock:
+			return "pthread_mutex_lock";
+		case ViolationKind::MutexTryLock:
+			return "pthread_mutex_trylock";
+		case ViolationKind::countKinds:
+			break;
+		}
+		return "unknown";
+	}
+
+	void initialise()
+	{
+		resolve(realMutexLock, "pthread_mutex_lock");
+		resolve(realMutexTryLock, "pthread_mutex_trylock");
+
+		// -- the first backtrace loads the unwinder, which allocates
+		void* frames[4];
+		backtrace(frames, 4);
+	}
+
+	ScopedRealtimeSection::ScopedRealtimeSection()
+	{
+		++realtimeDepth;
+	}
+
+	ScopedRealtimeSection::~ScopedRealtimeSection()
+	{
+		--realtimeDepth;
+	}
+
+	int getNumViolations()
+	{
+		return numViolations.load(std::memory_order_acquire);
+	}
+
+	int getNumDroppedViolations()
+	{
+		return numDroppedViolations.load(std::memory_order_acquire);
+	}
+
+	const Violation& getViolation(int index)
+	{
+		return violations[index];
+	}
+
+	void clearViolations()
+	{
+		numViolations.store(0, std::memory_order_release);
+		numDroppedViolations.store(0, std::memory_order_release);
+	}
+}
+
+//==============================================================================
+// -- C allocation functions
+//------------------------------------------------------------------------------
+using RealtimeInterposer::ViolationKind;
+
+extern "C" void* malloc(std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::Malloc, size);
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::Calloc, count * size);
+	return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::Realloc, size);
+	return __libc_realloc(ptr, size);
+}
+
+extern "C" void* memalign(std::size_t alignment, std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::AlignedAlloc, size);
+	return __libc_memalign(alignment, size);
+}
+
+extern "C" void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::AlignedAlloc, size);
+	return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** ptr, std::size_t alignment, std::size_t size)
+{
+	RealtimeInterposer::record(ViolationKind::AlignedAlloc, size);
+	*ptr = __libc_memalign(alignment, size);
+	return *ptr != nullptr ? 0 : ENOMEM;
+}
+
+extern "C" void free(void* ptr)
+{
+	if (ptr != nullptr)
+	{
+		RealtimeInterposer::record(ViolationKind::Free, 0);
+	}
+	__libc_free(ptr);
+}
+
+//==============================================================================
+// -- pthread mutexes
+//------------------------------------------------------------------------------
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+	RealtimeInterposer::record(ViolationKind::MutexLock, 0);
+	return RealtimeInterposer::resolve(RealtimeInterposer::realMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+extern "C" int pthread_mutex_trylock(pthread_mutex_t* mutex)
+{
+	RealtimeInterposer::record(ViolationKind::MutexTryLock, 0);
+	return RealtimeInterposer::resolve(RealtimeInterposer::realMutexTryLock, "pthread_mutex_trylock")(mutex);
+}
+
+//==============================================================================
+// -- C++ allocation functions -- forward straight to libc so they are reported once
+//------------------------------------------------------------------------------
+namespace
+{
+	void* allocate(std::size_t size, std::size_t alignment = 0)
+	{
+		RealtimeInterposer::record(ViolationKind::OperatorNew, size);
+		size = size == 0 ? 1 : size;
+		return alignment == 0 ? __libc_malloc(size) : __libc_memalign(alignment, size);
+	}
+
+	void deallocate(void* ptr)
+	{
+		if (ptr != nullptr)
+		{
+			RealtimeInterposer::record(ViolationKind::OperatorDelete, 0);
+		}
+		__libc_free(ptr);
+	}
+
+	void* allocateOrThrow(std::size_t size, std::size_t alignment = 0)
+	{
+		if (void* ptr = allocate(size, alignment))
+		{
+			return ptr;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
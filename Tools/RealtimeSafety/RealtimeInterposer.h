@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+	RealtimeInterposer.h
+	Traps heap allocations and mutex locks made by the thread inside a ScopedRealtimeSection
+
+	Linux/glibc only: malloc/calloc/realloc/free/memalign, operator new/delete and
+	pthread_mutex_lock/trylock are replaced in the executable and forward to the libc
+	implementations. Violations are stored in a fixed pool (no allocation while recording)
+	and read back once the realtime section is over.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace RealtimeInterposer
+{
+	//==============================================================================
+	enum class ViolationKind
+	{
+		Malloc,
+		Calloc,
+		Realloc,
+		AlignedAlloc,
+		Free,
+		OperatorNew,
+		OperatorDelete,
+		MutexLock,
+		MutexTryLock,
+		//==============================================================================
+		countKinds
+	};
+
+	const char* toString(ViolationKind kind);
+
+	static constexpr int maxFrames{ 48 };
+	static constexpr int maxViolations{ 512 };
+
+	struct Violation
+	{
+		ViolationKind kind;
+		std::size_t size;
+		int numFrames;
+		void* frames[maxFrames];
+	};
+
+	//==============================================================================
+	// -- Resolves the forwarded symbols and primes the unwinder, call once before any realtime section
+	void initialise();
+
+	// -- Recording is enabled for the calling thread while one of these is alive
+	class ScopedRealtimeSection
+	{
+	public:
+		ScopedRealtimeSection();
+		~ScopedRealtimeSection();
+	};
+
+	//==============================================================================
+	int getNumViolations();
+	int getNumDroppedViolations(); // -- violations that did not fit in the pool
+	const Violation& getViolation(int index);
+	void clearViolations();
+}
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+	RealtimeSafetyMain.cpp
+	Real-time safety check: traps heap allocations and mutex locks made inside
+	TalkingHeadsPluginAudioProcessor::processBlock
+
+	usage: talkingheads_rtcheck [--blocks 2000] [--block-sizes 64,512] [--sample-rate 48000] [--no-sweep]
+
+	By default every parameter is automated each block (bypasses and choices toggled too) so the
+	per-block update paths run. Each distinct violation is reported once with its stack and the
+	parameter state of the block that triggered it. Returns 1 if anything was trapped.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <iostream>
+#include <map>
+#include "PluginProcessor.h"
+#include "RealtimeInterposer.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	juce::String demangle(const char* symbol)
+	{
+		// -- backtrace_symbols format: module(mangled+offset) [address]
+		juce::String line(symbol);
+		auto mangled = line.fromFirstOccurrenceOf("(", false, false).upToFirstOccurrenceOf("+", false, false);
+		if (mangled.isEmpty())
+		{
+			return line;
+		}
+
+		int status = 0;
+		char* demangled = abi::__cxa_demangle(mangled.toRawUTF8(), nullptr, nullptr, &status);
+		if (status != 0 || demangled == nullptr)
+		{
+			return line;
+		}
+
+		juce::String result = line.upToFirstOccurrenceOf("(", false, false) + ": " + demangled;
+		std::free(demangled);
+		return result;
+	}
+
+	juce::uint64 hashStack(const RealtimeInterposer::Violation& violation)
+	{
+		juce::uint64 hash = static_cast<juce::uint64>(violation.kind) + 0x9e3779b97f4a7c15ull;
+		for (int i{ 0 }; i < violation.numFrames; ++i)
+		{
+			hash ^= reinterpret_cast<juce::uint64>(violation.frames[i]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+		}
+		return hash;
+	}
+
+	void printParameterState(juce::AudioProcessor& processor)
+	{
+		for (auto* parameter : processor.getParameters())
+		{
+			std::cout << "      " << parameter->getName(64) << " = " << parameter->getCurrentValueAsText() << std::endl;
+		}
+	}
+
+	void printViolation(const RealtimeInterposer::Violation& violation, int blockSize, int block)
+	{
+		std::cout << "  " << RealtimeInterposer::toString(violation.kind);
+		if (violation.size > 0)
+		{
+			std::cout << " (" << violation.size << " bytes)";
+		}
+		std::cout << " -- block size " << blockSize << ", block " << block << std::endl;
+
+		if (char** symbols = backtrace_symbols(violation.frames, violation.numFrames))
+		{
+			for (int i{ 0 }; i < violation.numFrames; ++i)
+			{
+				std::cout << "    #" << i << " " << demangle(symbols[i]) << std::endl;
+			}
+			std::free(symbols);
+		}
+	}
+
+	//==============================================================================
+	// -- Moves every parameter to a new position: floats sweep, bools and choices step through their values
+	void automateParameters(juce::AudioProcessor& processor, int block)
+	{
+		auto& parameters = processor.getParameters();
+		for (int i{ 0 }; i < parameters.size(); ++i)
+		{
+			auto* parameter = parameters[i];
+			const int numSteps = parameter->getNumSteps();
+			float value;
+			if (parameter->isDiscrete() && numSteps > 1 && numSteps < 64)
+			{
+				value = static_cast<float>((block / 8 + i) % numSteps) / static_cast<float>(numSteps - 1);
+			}
+			else
+			{
+				value = 0.5f + 0.5f * std::sin(0.07f * static_cast<float>(block) + static_cast<float>(i));
+			}
+			parameter->setValueNotifyingHost(value);
+		}
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	const int numBlocks = ToolUtilities::getIntOption(args, "--blocks", 2000);
+	const double sampleRate = ToolUtilities::getDoubleOption(args, "--sample-rate", 48000.0);
+	const bool sweep = !args.containsOption("--no-sweep");
+
+	std::vector<int> blockSizes;
+	for (auto& token : juce::StringArray::fromTokens(ToolUtilities::getStringOption(args, "--block-sizes", "64,512"), ",", ""))
+	{
+		blockSizes.push_back(token.getIntValue());
+	}
+
+	RealtimeInterposer::initialise();
+
+	std::map<juce::uint64, int> violationCounts;
+	int totalViolations = 0;
+
+	for (auto blockSize : blockSizes)
+	{
+		TalkingHeadsPluginAudioProcessor processor;
+		ToolUtilities::prepareProcessor(processor, sampleRate, blockSize);
+
+		juce::AudioBuffer<float> buffer(ToolUtilities::getNumProcessingChannels(processor), blockSize);
+		juce::MidiBuffer midi;
+		juce::Random random(0x5afe);
+
+		for (int block{ 0 }; block < numBlocks; ++block)
+		{
+			// -- Host side work, not checked
+			if (sweep)
+			{
+				automateParameters(processor, block);
+			}
+			buffer.clear();
+			for (int i{ 0 }; i < blockSize; ++i)
+			{
+				buffer.setSample(0, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+			}
+
+			RealtimeInterposer::clearViolations();
+			{
+				RealtimeInterposer::ScopedRealtimeSection realtimeSection;
+				processor.processBlock(buffer, midi);
+			}
+
+			const int numViolations = RealtimeInterposer::getNumViolations();
+			totalViolations += numViolations + RealtimeInterposer::getNumDroppedViolations();
+
+			bool parameterStatePrinted = false;
+			for (int i{ 0 }; i < numViolations; ++i)
+			{
+				const auto& violation = RealtimeInterposer::getViolation(i);
+				if (violationCounts[hashStack(violation)]++ > 0)
+				{
+					continue;
+				}
+
+				printViolation(violation, blockSize, block);
+				if (!parameterStatePrinted)
+				{
+					std::cout << "    parameter state:" << std::endl;
+					printParameterState(processor);
+					parameterStatePrinted = true;
+				}
+			}
+		}
+	}
+
+	//==============================================================================
+	std::cout << totalViolations << " violation(s), " << violationCounts.size() << " distinct stack(s)" << std::endl;
+	return totalViolations > 0 ? 1 : 0;
+}
@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+	RenderMain.cpp
+	Headless offline render: streams a WAV file through TalkingHeadsPluginAudioProcessor::processBlock
+
+	usage: talkingheads_render <input.wav> [--output out.wav] [--block-size 512] [--loops 1] [--implementation optimised|reference]
+		[--telemetry 30]
+
+	Reports the real-time factor (processing time / audio time) and ns/sample of processBlock only,
+	file IO is not timed. --implementation reference runs the processor on the Reference kernels,
+	optimised the cascaded MultiBandEQ; without it the build default (TALKINGHEADS_OPTIMISED_DSP) runs.
+
+	--telemetry drains the processor's TelemetryChannel the way an editor would, at the given rate in
+	frames per second of audio, and checks every frame against the blocks rendered since the last one:
+	block and sample counts, output peak and RMS, finite levels and gain reductions, no dropped blocks.
+	Returns 1 on any mismatch. The draining is not timed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <iostream>
+#include "PluginProcessor.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	// -- Consumer side of the TelemetryChannel, checked against what the render saw
+	class TelemetryCheck
+	{
+	public:
+		TelemetryCheck(TelemetryChannel& telemetry, int blocksPerFrame) :
+			telemetry(telemetry),
+			blocksPerFrame(juce::jlimit(1, TelemetryChannel::fifoSize - 1, blocksPerFrame)) // -- drain before the FIFO can fill
+		{
+			telemetry.attach();
+		}
+
+		void addBlock(const juce::AudioBuffer<float>& output, int numSamples)
+		{
+			for (int channel{ 0 }; channel < output.getNumChannels(); ++channel)
+			{
+				const float* samples = output.getReadPointer(channel);
+				auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+				expectedPeak = juce::jmax(expectedPeak, -range.getStart(), range.getEnd());
+				for (int i{ 0 }; i < numSamples; ++i)
+				{
+					expectedSumOfSquares += static_cast<double>(samples[i]) * samples[i];
+				}
+			}
+			expectedNumChannelSamples += static_cast<juce::int64>(output.getNumChannels()) * numSamples;
+			expectedNumSamples += numSamples;
+			++expectedNumBlocks;
+
+			if (expectedNumBlocks >= blocksPerFrame)
+			{
+				checkFrame();
+			}
+		}
+
+		void finish()
+		{
+			if (expectedNumBlocks > 0)
+			{
+				checkFrame();
+			}
+		}
+
+		bool passed() const
+		{
+			return numMismatches == 0 && telemetry.getNumDroppedBlocks() == 0;
+		}
+
+		void report() const
+		{
+			std::cout << "telemetry:        " << numFrames << " frames, " << numMismatches << " mismatches, "
+				<< telemetry.getNumDroppedBlocks() << " dropped blocks" << std::endl;
+		}
+
+	private:
+		TelemetryChannel& telemetry;
+		const int blocksPerFrame;
+
+		int expectedNumBlocks{ 0 };
+		int expectedNumSamples{ 0 };
+		juce::int64 expectedNumChannelSamples{ 0 };
+		float expectedPeak{ 0.f };
+		double expectedSumOfSquares{ 0.0 };
+
+		int numFrames{ 0 };
+		int numMismatches{ 0 };
+
+		void checkFrame()
+		{
+			const auto frame = telemetry.drain();
+			++numFrames;
+
+			const auto& output = frame.levels[enumToInt(TelemetryStage::output)];
+			const float expectedRms = expectedNumChannelSamples > 0
+				? static_cast<float>(std::sqrt(expectedSumOfSquares / static_cast<double>(expectedNumChannelSamples)))
+				: 0.f;
+
+			bool isValid = frame.numBlocks == expectedNumBlocks
+				&& frame.numSamples == expectedNumSamples
+				&& juce::approximatelyEqual(output.peak, expectedPeak) // -- same float maximum on both sides
+				&& std::abs(output.rms - expectedRms) <= 1.0e-4f * juce::jmax(expectedRms, 1.0e-6f); // -- per block float RMS, recombined
+			for (const auto& levels : frame.levels)
+			{
+				isValid = isValid && std::isfinite(levels.peak) && std::isfinite(levels.rms) && levels.rms <= levels.peak * (1.f + 1.0e-5f) + 1.0e-6f;
+			}
+			for (float gainReduction : frame.gainReductionDecibels)
+			{
+				isValid = isValid && std::isfinite(gainReduction) && gainReduction >= 0.f;
+			}
+
+			if (!isValid)
+			{
+				if (numMismatches == 0)
+				{
+					std::cerr << "telemetry frame " << numFrames << ": " << frame.numBlocks << "/" << expectedNumBlocks << " blocks, "
+						<< frame.numSamples << "/" << expectedNumSamples << " samples, output peak " << output.peak << "/" << expectedPeak
+						<< ", rms " << output.rms << "/" << expectedRms << std::endl;
+				}
+				++numMismatches;
+			}
+
+			expectedNumBlocks = 0;
+			expectedNumSamples = 0;
+			expectedNumChannelSamples = 0;
+			expectedPeak = 0.f;
+			expectedSumOfSquares = 0.0;
+		}
+	};
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	if (args.size() < 1 || args.containsOption("--help|-h"))
+	{
+		std::cout << "usage: talkingheads_render <input.wav> [--output out.wav] [--block-size 512] [--loops 1] [--implementation optimised|reference] [--telemetry 30]" << std::endl;
+		return args.size() < 1 ? 1 : 0;
+	}
+
+	const juce::File inputFile = args[0].resolveAsFile();
+	const int blockSize = ToolUtilities::getIntOption(args, "--block-size", 512);
+	const int loops = juce::jmax(1, ToolUtilities::getIntOption(args, "--loops", 1));
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	const juce::String implementationName = ToolUtilities::getStringOption(args, "--implementation");
+	const auto implementation = implementationName == "reference" ? DSPImplementation::Reference
+		: implementationName == "optimised" ? DSPImplementation::Optimised
+		: defaultDSPImplementation;
+	const double telemetryFramesPerSecond = ToolUtilities::getDoubleOption(args, "--telemetry", 0.0);
+
+	//==============================================================================
+	// -- Input
+	juce::AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+
+	std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+	if (reader == nullptr)
+	{
+		std::cerr << "could not read " << inputFile.getFullPathName() << std::endl;
+		return 1;
+	}
+
+	const double sampleRate = reader->sampleRate;
+	const juce::int64 lengthInSamples = reader->lengthInSamples;
+
+	//==============================================================================
+	// -- Processor
+	TalkingHeadsPluginAudioProcessor processor;
+	processor.setDSPImplementation(implementation);
+	ToolUtilities::prepareProcessor(processor, sampleRate, blockSize);
+
+	const int numChannels = ToolUtilities::getNumProcessingChannels(processor);
+	juce::AudioBuffer<float> buffer(numChannels, blockSize);
+	juce::AudioBuffer<float> readBuffer(static_cast<int>(reader->numChannels), blockSize);
+	juce::MidiBuffer midi;
+
+	std::unique_ptr<TelemetryCheck> telemetryCheck;
+	if (telemetryFramesPerSecond > 0.0)
+	{
+		telemetryCheck = std::make_unique<TelemetryCheck>(processor.getTelemetry(), juce::roundToInt(sampleRate / (telemetryFramesPerSecond * blockSize)));
+	}
+
+	//==============================================================================
+	// -- Output
+	std::unique_ptr<juce::AudioFormatWriter> writer;
+	if (outputPath.isNotEmpty())
+	{
+		juce::File outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+		outputFile.deleteFile();
+
+		juce::WavAudioFormat wavFormat;
+		if (auto* stream = outputFile.createOutputStream().release())
+		{
+			writer.reset(wavFormat.createWriterFor(stream, sampleRate, static_cast<unsigned int>(processor.getTotalNumOutputChannels()), 24, {}, 0));
+			if (writer == nullptr)
+			{
+				delete stream;
+			}
+		}
+		if (writer == nullptr)
+		{
+			std::cerr << "could not write " << outputFile.getFullPathName() << std::endl;
+			return 1;
+		}
+	}
+
+	//==============================================================================
+	// -- Render
+	juce::int64 processTicks = 0;
+	juce::int64 samplesProcessed = 0;
+#if TALKINGHEADS_STAGE_PROFILING
+	StageProfiler::Statistics stageStatistics;
+#endif
+
+	for (int loop{ 0 }; loop < loops; ++loop)
+	{
+		for (juce::int64 position{ 0 }; position < lengthInSamples; position += blockSize)
+		{
+			const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, lengthInSamples - position));
+
+			reader->read(&readBuffer, 0, numSamples, position, true, true);
+
+			// -- mono input: downmix whatever the file has into channel 0
+			buffer.setSize(numChannels, numSamples, false, false, true);
+			buffer.clear();
+			for (int channel{ 0 }; channel < readBuffer.getNumChannels(); ++channel)
+			{
+				buffer.addFrom(0, 0, readBuffer, channel, 0, numSamples, 1.f / static_cast<float>(readBuffer.getNumChannels()));
+			}
+
+			const auto start = juce::Time::getHighResolutionTicks();
+			processor.processBlock(buffer, midi);
+			processTicks += juce::Time::getHighResolutionTicks() - start;
+			samplesProcessed += numSamples;
+
+			if (telemetryCheck != nullptr)
+			{
+				telemetryCheck->addBlock(buffer, numSamples);
+			}
+
+			if (writer != nullptr && loop == 0)
+			{
+				writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+			}
+
+#if TALKINGHEADS_STAGE_PROFILING
+			stageStatistics = processor.getStageProfiler().drain();
+#endif
+		}
+	}
+
+	if (telemetryCheck != nullptr)
+	{
+		telemetryCheck->finish();
+	}
+
+	processor.releaseResources();
+
+	//==============================================================================
+	// -- Report
+	const double processNs = ToolUtilities::ticksToNanoseconds(processTicks);
+	const double audioSeconds = static_cast<double>(samplesProcessed) / sampleRate;
+	const double realTimeFactor = audioSeconds > 0.0 ? (processNs * 1.0e-9) / audioSeconds : 0.0;
+	const double nsPerSample = samplesProcessed > 0 ? processNs / static_cast<double>(samplesProcessed) : 0.0;
+
+	std::cout << "input:            " << inputFile.getFullPathName() << std::endl;
+	std::cout << "sample rate:      " << sampleRate << " Hz" << std::endl;
+	std::cout << "block size:       " << blockSize << std::endl;
+	std::cout << "implementation:   " << (implementation == DSPImplementation::Optimised ? "optimised" : "reference") << std::endl;
+	std::cout << "samples:          " << samplesProcessed << " (" << audioSeconds << " s)" << std::endl;
+	std::cout << "process time:     " << processNs * 1.0e-6 << " ms" << std::endl;
+	std::cout << "real-time factor: " << realTimeFactor << " (" << (realTimeFactor > 0.0 ? 1.0 / realTimeFactor : 0.0) << "x real time)" << std::endl;
+	std::cout << "ns/sample:        " << nsPerSample << std::endl;
+
+#if TALKINGHEADS_STAGE_PROFILING
+	std::cout << "stage timing over the last " << stageStatistics[0].count << " blocks (ns/block min / mean / p99):" << std::endl;
+	for (int stage{ 0 }; stage < StageProfiler::numStages; ++stage)
+	{
+		const auto& statistics = stageStatistics[stage];
+		std::cout << "  " << juce::String(StageProfiler::getStageName(intToEnum(stage, ProfiledStage))).paddedRight(' ', 20)
+			<< statistics.minNs << " / " << statistics.meanNs << " / " << statistics.p99Ns << std::endl;
+	}
+#endif
+
+	if (telemetryCheck != nullptr)
+	{
+		telemetryCheck->report();
+		if (!telemetryCheck->passed())
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+	ReplayMain.cpp
+	Deterministic replay of an automation trace recorded with TALKINGHEADS_AUTOMATION_TRACE
+
+	usage: talkingheads_replay <trace.thtrace> [--input in.wav] [--output out.wav] [--runs 3] [--seed 1] [--worst 10]
+
+	Rebuilds the recorded session: same sample rate, same block sizes, same inbound parameter values per block,
+	starting from the values of the first block rather than ramping to them from the defaults.
+	The input is the given WAV (looped, mono downmix) or seeded noise, so every run renders the same audio.
+	Each run uses a fresh processor; the output hash must match across runs and between builds that are
+	meant to be bit exact. Reports per-block timing against the block deadline and the worst blocks.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <iostream>
+#include "PluginProcessor.h"
+#include "AutomationTrace.h"
+#include "ToolUtilities.h"
+
+namespace
+{
+	//==============================================================================
+	// -- Mono input source, either a looped file or seeded noise
+	class ReplayInput
+	{
+	public:
+		ReplayInput(int seed) :
+			random(seed)
+		{
+		}
+
+		bool loadFile(const juce::File& file)
+		{
+			juce::AudioFormatManager formatManager;
+			formatManager.registerBasicFormats();
+
+			std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+			if (reader == nullptr || reader->lengthInSamples <= 0)
+			{
+				return false;
+			}
+
+			const int length = static_cast<int>(reader->lengthInSamples);
+			juce::AudioBuffer<float> readBuffer(static_cast<int>(reader->numChannels), length);
+			reader->read(&readBuffer, 0, length, 0, true, true);
+
+			samples.setSize(1, length);
+			samples.clear();
+			for (int channel{ 0 }; channel < readBuffer.getNumChannels(); ++channel)
+			{
+				samples.addFrom(0, 0, readBuffer, channel, 0, length, 1.f / static_cast<float>(readBuffer.getNumChannels()));
+			}
+			return true;
+		}
+
+		void fill(float* destination, int numSamples)
+		{
+			if (samples.getNumSamples() == 0)
+			{
+				for (int i{ 0 }; i < numSamples; ++i)
+				{
+					destination[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+				}
+				return;
+			}
+
+			const float* source = samples.getReadPointer(0);
+			for (int i{ 0 }; i < numSamples; ++i)
+			{
+				destination[i] = source[position];
+				position = (position + 1) % samples.getNumSamples();
+			}
+		}
+
+	private:
+		juce::Random random;
+		juce::AudioBuffer<float> samples;
+		int position{ 0 };
+	};
+
+	//==============================================================================
+	// -- FNV-1a over the sample bits
+	juce::uint64 hashSamples(juce::uint64 hash, const float* samples, int numSamples)
+	{
+		const auto* bytes = reinterpret_cast<const juce::uint8*>(samples);
+		for (size_t i{ 0 }; i < static_cast<size_t>(numSamples) * sizeof(float); ++i)
+		{
+			hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	struct BlockTiming
+	{
+		int index;
+		int numSamples;
+		double ns;
+	};
+
+	struct RunResult
+	{
+		juce::uint64 hash{ 0xcbf29ce484222325ull };
+		std::vector<BlockTiming> blocks;
+	};
+
+	//==============================================================================
+	RunResult runReplay(const juce::MemoryBlock& trace, const juce::String& inputPath, int seed, juce::AudioFormatWriter* writer)
+	{
+		RunResult result;
+
+		// -- the tool walks the trace for the block sizes, the processor for the values
+		AutomationTracePlayer blockSizes;
+		blockSizes.load(trace);
+
+		TalkingHeadsPluginAudioProcessor processor;
+		ToolUtilities::prepareProcessor(processor, blockSizes.getSampleRate(), blockSizes.getMaxBlockSize());
+		processor.startAutomationReplay(trace);
+
+		ReplayInput input(seed);
+		if (inputPath.isNotEmpty())
+		{
+			input.loadFile(juce::File::getCurrentWorkingDirectory().getChildFile(inputPath));
+		}
+
+		const int numChannels = ToolUtilities::getNumProcessingChannels(processor);
+		juce::AudioBuffer<float> buffer(numChannels, blockSizes.getMaxBlockSize());
+		juce::MidiBuffer midi;
+		result.blocks.reserve(static_cast<size_t>(blockSizes.getNumBlocks()));
+
+		int numSamples = 0;
+		AutomationTrace::Values values;
+		for (int index{ 0 }; blockSizes.readBlock(numSamples, values); ++index)
+		{
+			buffer.setSize(numChannels, numSamples, false, false, true);
+			buffer.clear();
+			input.fill(buffer.getWritePointer(0), numSamples);
+
+			const auto start = juce::Time::getHighResolutionTicks();
+			processor.processBlock(buffer, midi);
+			result.blocks.push_back({ index, numSamples, ToolUtilities::ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start) });
+
+			for (int channel{ 0 }; channel < processor.getTotalNumOutputChannels(); ++channel)
+			{
+				result.hash = hashSamples(result.hash, buffer.getReadPointer(channel), numSamples);
+			}
+
+			if (writer != nullptr)
+			{
+				writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+			}
+		}
+
+		processor.stopAutomationReplay();
+		processor.releaseResources();
+		return result;
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::ArgumentList args(argc, argv);
+
+	if (args.size() < 1 || args.containsOption("--help|-h"))
+	{
+		std::cout << "usage: talkingheads_replay <trace.thtrace> [--input in.wav] [--output out.wav] [--runs 3] [--seed 1] [--worst 10]" << std::endl;
+		return args.size() < 1 ? 1 : 0;
+	}
+
+	const juce::File traceFile = args[0].resolveAsFile();
+	const juce::String inputPath = ToolUtilities::getStringOption(args, "--input");
+	const juce::String outputPath = ToolUtilities::getStringOption(args, "--output");
+	const int runs = juce::jmax(1, ToolUtilities::getIntOption(args, "--runs", 3));
+	const int seed = ToolUtilities::getIntOption(args, "--seed", 1);
+	const int numWorst = juce::jmax(0, ToolUtilities::getIntOption(args, "--worst", 10));
+
+	//==============================================================================
+	// -- Trace
+	juce::MemoryBlock trace;
+	AutomationTracePlayer player;
+	if (!traceFile.loadFileAsData(trace) || !player.load(trace))
+	{
+		std::cerr << "could not load trace " << traceFile.getFullPathName() << std::endl;
+		return 1;
+	}
+
+	const double sampleRate = player.getSampleRate();
+
+	//==============================================================================
+	// -- Output, written from the first run only
+	std::unique_ptr<juce::AudioFormatWriter> writer;
+	if (outputPath.isNotEmpty())
+	{
+		juce::File outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+		outputFile.deleteFile();
+
+		juce::WavAudioFormat wavFormat;
+		if (auto* stream = outputFile.createOutputStream().release())
+		{
+			writer.reset(wavFormat.createWriterFor(stream, sampleRate, 2, 32, {}, 0));
+			if (writer == nullptr)
+			{
+				delete stream;
+			}
+		}
+		if (writer == nullptr)
+		{
+			std::cerr << "could not write " << outputFile.getFullPathName() << std::endl;
+			return 1;
+		}
+	}
+
+	//==============================================================================
+	// -- Replay
+	std::vector<RunResult> results;
+	for (int run{ 0 }; run < runs; ++run)
+	{
+		results.push_back(runReplay(trace, inputPath, seed, run == 0 ? writer.get() : nullptr));
+	}
+	writer.reset();
+
+	bool deterministic = true;
+	for (const auto& result : results)
+	{
+		deterministic = deterministic && result.hash == results.front().hash;
+	}
+
+	//==============================================================================
+	// -- Report -- timing from the last run, the earlier ones warm the caches
+	auto& blocks = results.back().blocks;
+
+	std::vector<double> blockNs;
+	juce::int64 numSamplesTotal = 0;
+	int missedDeadlines = 0;
+	for (const auto& block : blocks)
+	{
+		blockNs.push_back(block.ns);
+		numSamplesTotal += block.numSamples;
+		if (block.ns > 1.0e9 * block.numSamples / sampleRate)
+		{
+			++missedDeadlines;
+		}
+	}
+	auto summary = ToolUtilities::summarise(blockNs);
+
+	std::cout << "trace:            " << traceFile.getFullPathName() << std::endl;
+	std::cout << "sample rate:      " << sampleRate << " Hz" << std::endl;
+	std::cout << "blocks:           " << player.getNumBlocks() << " (max " << player.getMaxBlockSize() << " samples, " << numSamplesTotal / sampleRate << " s)" << std::endl;
+	std::cout << "input:            " << (inputPath.isNotEmpty() ? inputPath : "noise, seed " + juce::String(seed)) << std::endl;
+	std::cout << "output hash:      " << juce::String::toHexString(static_cast<juce::int64>(results.front().hash))
+		<< (deterministic ? " (identical across " + juce::String(runs) + " runs)" : " (DIFFERS between runs)") << std::endl;
+	std::cout << "ns/block:         min " << summary.minNs << ", mean " << summary.meanNs << ", p99 " << summary.p99Ns
+		<< ", p99.9 " << summary.p999Ns << ", max " << summary.maxNs << std::endl;
+	std::cout << "missed deadlines: " << missedDeadlines << std::endl;
+
+	std::sort(blocks.begin(), blocks.end(), [](const BlockTiming& a, const BlockTiming& b) { return a.ns > b.ns; });
+	std::cout << "worst blocks (index, samples, ns, % of deadline):" << std::endl;
+	for (int i{ 0 }; i < juce::jmin(numWorst, static_cast<int>(blocks.size())); ++i)
+	{
+		const auto& block = blocks[static_cast<size_t>(i)];
+		std::cout << "  " << block.index << ", " << block.numSamples << ", " << block.ns
+			<< ", " << block.ns / (1.0e9 * block.numSamples / sampleRate) * 100.0 << "%" << std::endl;
+	}
+
+	return deterministic ? 0 : 1;
+}